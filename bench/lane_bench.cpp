@@ -0,0 +1,128 @@
+// Micro-benchmark of the batched passing-lane kernels.
+//
+//   lane_bench [iterations]
+//
+// Times laneDistances() at every SIMD level this CPU supports, for batch
+// sizes the AI actually produces (9 shot lines, a team's pass lanes, a
+// receiving-grid refresh) against 2, 5 and 11 opponents, next to the
+// one-segment-at-a-time loop the AI used before.  Every level's results
+// are compared bit for bit with that loop's.
+#define SDL_MAIN_HANDLED  // plain main(), no SDL2main needed
+#include "../include/LaneTests.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Deterministic pseudo-random positions on the 40x20 m pitch.
+static uint32_t rngState = 12345;
+static float randomIn(float lo, float hi) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return lo + (hi - lo) * (float)(rngState >> 8) / (float)(1u << 24);
+}
+
+// The per-lane loop AIAgent ran before batching: one call per segment.
+static float minDistanceOneLane(const Vector &from, const Vector &to,
+                                const float *ox, const float *oy, int n) {
+    const float abx = to.x - from.x;
+    const float aby = to.y - from.y;
+    const float len2 = std::max(0.0001f, abx * abx + aby * aby);
+    float best2 = 1e30f;
+    for (int i = 0; i < n; ++i) {
+        float t = (abx * (ox[i] - from.x) + aby * (oy[i] - from.y)) / len2;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        float dx = ox[i] - (from.x + abx * t);
+        float dy = oy[i] - (from.y + aby * t);
+        float d2 = dx * dx + dy * dy;
+        best2 = d2 < best2 ? d2 : best2;
+    }
+    return std::sqrt(best2);
+}
+
+template <typename F>
+static double nsPerLane(int iterations, int lanes, F run) {
+    run();  // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) run();
+    double ns = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - start).count();
+    return ns / ((double)iterations * lanes);
+}
+
+static const char *levelName(LaneSimd level) {
+    switch (level) {
+    case LaneSimd::SCALAR: return "scalar";
+    case LaneSimd::SSE2:   return "sse2";
+    case LaneSimd::AVX2:   return "avx2";
+    }
+    return "?";
+}
+
+int main(int argc, char **argv) {
+    int iterations = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const LaneSimd best = laneSimdSupported();
+    std::printf("best supported level: %s\n", levelName(best));
+    std::printf("%6s %4s %12s %10s %10s %10s %8s\n",
+                "lanes", "opp", "per-lane ns", "scalar ns", "sse2 ns", "avx2 ns", "speedup");
+
+    const int laneCounts[] = {9, 22, 160, 2409};
+    const int oppCounts[] = {2, 5, 11};
+    bool allMatch = true;
+    volatile float sink = 0.0f;  // keeps the loops from being optimised away
+
+    for (int lanesN : laneCounts) {
+        for (int oppN : oppCounts) {
+            LaneBatch lanes;
+            Vector ball(randomIn(0, 40), randomIn(0, 20));
+            for (int i = 0; i < lanesN; ++i) {
+                lanes.add(ball, Vector(randomIn(0, 40), randomIn(0, 20)));
+            }
+            std::vector<float> ox(oppN), oy(oppN);
+            for (int i = 0; i < oppN; ++i) {
+                ox[i] = randomIn(0, 40);
+                oy[i] = randomIn(0, 20);
+            }
+
+            int reps = std::max(1, iterations * 9 / lanesN);
+            std::vector<float> out(lanesN), reference(lanesN);
+
+            double perLane = nsPerLane(reps, lanesN, [&] {
+                for (int i = 0; i < lanesN; ++i) {
+                    reference[i] = minDistanceOneLane(Vector(lanes.ax[i], lanes.ay[i]),
+                                                      Vector(lanes.bx[i], lanes.by[i]),
+                                                      ox.data(), oy.data(), oppN);
+                }
+                sink = sink + reference[0];
+            });
+
+            double ns[3] = {0, 0, 0};
+            for (LaneSimd level : {LaneSimd::SCALAR, LaneSimd::SSE2, LaneSimd::AVX2}) {
+                if (level > best) continue;
+                setLaneSimdLevel(level);
+                ns[(int)level] = nsPerLane(reps, lanesN, [&] {
+                    laneDistances(lanes, ox.data(), oy.data(), oppN, out.data());
+                    sink = sink + out[0];
+                });
+                if (std::memcmp(out.data(), reference.data(), lanesN * sizeof(float)) != 0) {
+                    std::printf("MISMATCH: %s, %d lanes, %d opponents\n",
+                                levelName(level), lanesN, oppN);
+                    allMatch = false;
+                }
+            }
+            setLaneSimdLevel(best);
+
+            std::printf("%6d %4d %12.2f %10.2f %10.2f %10.2f %7.1fx\n",
+                        lanesN, oppN, perLane, ns[0], ns[1], ns[2],
+                        perLane / ns[(int)best]);
+        }
+    }
+
+    std::printf(allMatch ? "all levels bit-identical to the per-lane loop\n"
+                         : "results differ between levels\n");
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,490 @@
+// Micro-benchmark suite for the simulation core.
+//
+//   sigma_bench [--filter TEXT] [--min-time SECONDS] [--out FILE]
+//               [--baseline FILE] [--tolerance PERCENT]
+//
+// Google Benchmark style: every benchmark is a function that sets up its
+// data and then runs its body in a `while (state.keepRunning())` loop; the
+// harness grows the iteration count until one run lasts --min-time, then
+// repeats it and reports the median time per iteration.  Benchmarks take
+// arguments (state.range(i)) and are run once per registered argument set,
+// named like "ai_shot_target/5/11".
+//
+// --out writes "name,ns" lines; --baseline compares against such a file
+// and exits with status 1 if any benchmark got slower by more than
+// --tolerance percent (default 10), so a merge can be checked against the
+// numbers of the commit before it on the same machine.
+#define SDL_MAIN_HANDLED  // plain main(), no SDL2main needed
+#include "../include/MatchSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Harness
+// ============================================================================
+class State {
+public:
+    State(long long iterations, const std::vector<int> &args)
+    : iterations(iterations), left(iterations), args(args), seconds(0.0), started(false) {}
+
+    // True while iterations are left.  The first call starts the clock and
+    // the last one stops it, so setup before the loop is not timed.
+    bool keepRunning() {
+        if (!started) {
+            started = true;
+            start = std::chrono::steady_clock::now();
+        }
+        if (left-- > 0) return true;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return false;
+    }
+
+    int range(int i) const { return args[i]; }
+    long long getIterations() const { return iterations; }
+    double getSeconds() const { return seconds; }
+
+private:
+    long long iterations;
+    long long left;
+    std::vector<int> args;
+    double seconds;
+    bool started;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Fixture data comes from here; every run starts from the same seed so
+// repeated runs time the same inputs.
+static uint32_t rngState = 12345;
+static float randomIn(float lo, float hi) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return lo + (hi - lo) * (float)(rngState >> 8) / (float)(1u << 24);
+}
+
+// Results are added here so the optimiser cannot drop the work.
+static volatile float sink = 0.0f;
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State &)> fn;
+    std::vector<std::vector<int>> argSets;   // one run per set; {} if none
+};
+
+static std::vector<Benchmark> &registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+static void addBenchmark(const char *name, std::function<void(State &)> fn,
+                         std::vector<std::vector<int>> argSets = {{}}) {
+    registry().push_back(Benchmark{name, fn, argSets});
+}
+
+static std::string instanceName(const Benchmark &b, const std::vector<int> &args) {
+    std::string name = b.name;
+    for (int a : args) name += "/" + std::to_string(a);
+    return name;
+}
+
+// Median nanoseconds per iteration of one benchmark instance.
+static double measure(const Benchmark &b, const std::vector<int> &args, double minTime,
+                      long long &iterationsOut) {
+    static const int REPETITIONS = 3;
+    long long iterations = 1;
+    for (;;) {
+        State state(iterations, args);
+        rngState = 12345;
+        b.fn(state);
+        double s = state.getSeconds();
+        if (s >= minTime || iterations >= (1LL << 40)) break;
+        // Aim a bit past minTime, growing at most tenfold per try
+        double grow = s > 0.0 ? minTime / s * 1.4 : 10.0;
+        grow = std::min(10.0, std::max(1.4, grow));
+        iterations = (long long)std::ceil(iterations * grow);
+    }
+    std::vector<double> ns;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        State state(iterations, args);
+        rngState = 12345;
+        b.fn(state);
+        ns.push_back(state.getSeconds() * 1e9 / iterations);
+    }
+    std::sort(ns.begin(), ns.end());
+    iterationsOut = iterations;
+    return ns[REPETITIONS / 2];
+}
+
+// ============================================================================
+// Fixtures
+// ============================================================================
+// The default pitch for 5 obstacles, otherwise a 40x20 m pitch with n
+// rectangles and circles scattered over the middle, away from the goals.
+static Field makeField(int obstacles) {
+    if (obstacles == 5) return MatchSimulation::createDefaultField();
+    Field field(40.0f, 20.0f);
+    uint32_t saved = rngState;
+    rngState = 777u + (uint32_t)obstacles;
+    for (int i = 0; i < obstacles; ++i) {
+        Vector c(randomIn(6.0f, 34.0f), randomIn(2.0f, 18.0f));
+        if (i % 2 == 0) {
+            field.addObstacle(Obstacle(c, randomIn(0.8f, 3.0f), randomIn(0.8f, 3.0f)));
+        } else {
+            field.addObstacle(Obstacle::circle(c, randomIn(0.4f, 1.2f)));
+        }
+    }
+    rngState = saved;
+    return field;
+}
+
+// Consecutive states of a real AI vs AI match, so the AI's caches see the
+// small frame-to-frame movement they see in a game.
+struct Scene {
+    Ball ball;
+    Team team1;
+    Team team2;
+};
+
+static const int SCENES = 256;
+
+static std::vector<Scene> recordScenes(const Field &field, int players) {
+    MatchSimulation sim(field, MODE_AI_VS_AI, 1e6f, players, 42);
+    MatchInputs none;
+    for (int i = 0; i < 240; ++i) sim.step(MatchSimulation::FIXED_DT, none);
+    std::vector<Scene> scenes;
+    for (int i = 0; i < SCENES; ++i) {
+        sim.step(MatchSimulation::FIXED_DT, none);
+        scenes.push_back(Scene{sim.getBall(), sim.getTeam1(), sim.getTeam2()});
+    }
+    return scenes;
+}
+
+// Calls the AI's private search helpers.
+struct AIAgentBench {
+    static void influence(AIAgent &ai, const Field &field, const Scene &s) {
+        ai.updateInfluence(field, true, s.team1.players, s.team2.players);
+    }
+    static Vector receivingPoint(AIAgent &ai, const Vector &supportPos,
+                                 const std::vector<Vector> &spacing, const Ball &ball,
+                                 const Field &field, const PlayerStore &opponents) {
+        return ai.findOptimalReceivingPoint(supportPos, spacing, ball, field, true, opponents);
+    }
+    static Vector shotTarget(const AIAgent &ai, const Vector &shooterPos, const Field &field,
+                             const PlayerStore &opponents) {
+        return ai.findBestShotTarget(shooterPos, field, true, opponents);
+    }
+};
+
+static const std::vector<std::vector<int>> BY_BATCH = {{16}, {256}, {4096}};
+static const std::vector<std::vector<int>> BY_PLAYERS = {{2}, {5}, {11}};
+static const std::vector<std::vector<int>> BY_OBSTACLES = {{0}, {5}, {20}};
+// obstacles x players per team
+static const std::vector<std::vector<int>> BY_BOTH = {
+    {0, 2}, {0, 5}, {0, 11}, {5, 2}, {5, 5}, {5, 11}, {20, 2}, {20, 5}, {20, 11}
+};
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+static void registerBenchmarks() {
+    // Normalise, dot and distance over a batch of vectors
+    addBenchmark("vector_ops", [](State &state) {
+        int n = state.range(0);
+        std::vector<Vector> a(n), b(n);
+        for (int i = 0; i < n; ++i) {
+            a[i] = Vector(randomIn(0, 40), randomIn(0, 20));
+            b[i] = Vector(randomIn(0, 40), randomIn(0, 20));
+        }
+        while (state.keepRunning()) {
+            float sum = 0.0f;
+            for (int i = 0; i < n; ++i) {
+                Vector d = (b[i] - a[i]).normalized();
+                sum += d.dot(a[i]) + a[i].distanceTo(b[i]) + a[i].lerp(b[i], 0.25f).lengthSquared();
+            }
+            sink = sink + sum;
+        }
+    }, BY_BATCH);
+
+    addBenchmark("ball_update", [](State &state) {
+        Ball ball(Vector(20, 10), Vector(15, 7));
+        while (state.keepRunning()) {
+            ball.update(MatchSimulation::FIXED_DT);
+            if (ball.vel.lengthSquared() < 1.0f) ball.reset(Vector(20, 10), Vector(15, 7));
+        }
+        sink = sink + ball.pos.x;
+    });
+
+    // The ball tested against every player of both teams
+    addBenchmark("ball_player_collision", [](State &state) {
+        const int n = 2 * state.range(0);
+        std::vector<Vector> players(n);
+        for (Vector &p : players) p = Vector(randomIn(15, 25), randomIn(6, 14));
+        Ball ball(Vector(20, 10), Vector(10, 4));
+        while (state.keepRunning()) {
+            ball.pos = Vector(20, 10);
+            for (int i = 0; i < n; ++i) ball.handlePlayerCollision(players[i], 0.8f);
+            sink = sink + ball.vel.x;
+        }
+    }, BY_PLAYERS);
+
+    // The ball's swept move for one step through the obstacle distance
+    // field (obstacles collide with the ball only through Field::moveBall)
+    addBenchmark("ball_obstacle_sweep", [](State &state) {
+        Field field = makeField(state.range(0));
+        PlayerStore nobody;
+        std::vector<Ball> starts;
+        for (int i = 0; i < 256; ++i) {
+            float angle = randomIn(0.0f, 6.2832f);
+            starts.push_back(Ball(Vector(randomIn(2, 38), randomIn(2, 18)),
+                                  Vector(std::cos(angle), std::sin(angle)) * 30.0f));
+        }
+        size_t i = 0;
+        while (state.keepRunning()) {
+            Ball ball = starts[i++ & 255];
+            sink = sink + (float)field.moveBall(ball, 4 * MatchSimulation::FIXED_DT, nobody, nobody);
+        }
+    }, BY_OBSTACLES);
+
+    addBenchmark("field_wall_collision", [](State &state) {
+        Field field = makeField(5);
+        std::vector<Ball> starts;
+        for (int i = 0; i < 256; ++i) {
+            // Half of them touching a wall or a goal box
+            Vector pos = (i & 1) ? Vector(randomIn(-0.5f, 40.5f), randomIn(-0.3f, 0.3f))
+                                 : Vector(randomIn(-0.3f, 0.3f), randomIn(-0.5f, 20.5f));
+            starts.push_back(Ball(pos, Vector(randomIn(-20, 20), randomIn(-20, 20))));
+        }
+        size_t i = 0;
+        while (state.keepRunning()) {
+            Ball ball = starts[i++ & 255];
+            sink = sink + (float)field.handleCollision(ball);
+        }
+    });
+
+    // The ball's whole path to rest and the earliest point a player can
+    // reach it, as the chasing player asks every step
+    addBenchmark("ball_intercept", [](State &state) {
+        Field field = makeField(state.range(0));
+        std::vector<Ball> starts;
+        std::vector<Vector> chasers;
+        for (int i = 0; i < 256; ++i) {
+            float angle = randomIn(0.0f, 6.2832f);
+            starts.push_back(Ball(Vector(randomIn(2, 38), randomIn(2, 18)),
+                                  Vector(std::cos(angle), std::sin(angle)) * randomIn(5, 30)));
+            chasers.push_back(Vector(randomIn(1, 39), randomIn(1, 19)));
+        }
+        BallPredictor predictor;
+        size_t i = 0;
+        while (state.keepRunning()) {
+            size_t k = i++ & 255;
+            predictor.predict(starts[k], field, MatchSimulation::FIXED_DT);
+            float when = 0.0f;
+            Vector where;
+            predictor.intercept(chasers[k], 6.0f, 1.0f, when, where);
+            sink = sink + when;
+        }
+    }, BY_OBSTACLES);
+
+    // One flow field rebuilt for a target that moved to another node
+    addBenchmark("ai_flow_field", [](State &state) {
+        Field field = makeField(state.range(0));
+        FlowField flow;
+        std::vector<Vector> targets;
+        for (int i = 0; i < 256; ++i) targets.push_back(Vector(randomIn(1, 39), randomIn(1, 19)));
+        size_t i = 0;
+        while (state.keepRunning()) {
+            flow.build(field, 0.8f, FlowField::nodeOf(field, targets[i++ & 255]));
+            sink = sink + flow.distance(Vector(2, 2));
+        }
+    }, BY_OBSTACLES);
+
+    // Team 1's influence map refresh for one step
+    addBenchmark("ai_influence_map", [](State &state) {
+        Field field = makeField(5);
+        std::vector<Scene> scenes = recordScenes(field, state.range(0));
+        AIAgent ai;
+        size_t i = 0;
+        while (state.keepRunning()) {
+            const Scene &s = scenes[i++ % SCENES];
+            AIAgentBench::influence(ai, field, s);
+            sink = sink + ai.getInfluence().pressure(s.ball.pos);
+        }
+    }, BY_PLAYERS);
+
+    // Team 1's influence map and every supporter's receiving-point search,
+    // one scene per iteration
+    addBenchmark("ai_receiving_point", [](State &state) {
+        Field field = makeField(state.range(0));
+        std::vector<Scene> scenes = recordScenes(field, state.range(1));
+        AIAgent ai;
+        std::vector<Vector> spacing;
+        size_t i = 0;
+        while (state.keepRunning()) {
+            const Scene &s = scenes[i++ % SCENES];
+            const PlayerStore &players = s.team1.players;
+            AIAgentBench::influence(ai, field, s);
+            int active = players.nearestTo(s.ball.pos);
+            spacing.assign(1, players.getPos(active));
+            for (int p = 0; p < players.size(); ++p) {
+                if (p == active) continue;
+                spacing.push_back(AIAgentBench::receivingPoint(ai, players.getPos(p), spacing,
+                                                               s.ball, field, s.team2.players));
+            }
+            sink = sink + spacing.back().x;
+        }
+    }, BY_BOTH);
+
+    addBenchmark("ai_shot_target", [](State &state) {
+        Field field = makeField(state.range(0));
+        std::vector<Scene> scenes = recordScenes(field, state.range(1));
+        AIAgent ai;
+        size_t i = 0;
+        while (state.keepRunning()) {
+            const Scene &s = scenes[i++ % SCENES];
+            int shooter = s.team1.players.nearestTo(s.ball.pos);
+            Vector target = AIAgentBench::shotTarget(ai, s.team1.players.getPos(shooter), field,
+                                                     s.team2.players);
+            sink = sink + target.y;
+        }
+    }, BY_BOTH);
+
+    // A fixed count of 64 rollouts for the nearest player's options
+    // (dribble, a shot, a pass to every teammate), one scene per iteration
+    addBenchmark("ai_rollout_plan", [](State &state) {
+        Field field = makeField(5);
+        std::vector<Scene> scenes = recordScenes(field, state.range(0));
+        AIAgent ai;
+        RolloutPlanner planner;
+        size_t i = 0;
+        while (state.keepRunning()) {
+            const Scene &s = scenes[i++ % SCENES];
+            const PlayerStore &players = s.team1.players;
+            AIAgentBench::influence(ai, field, s);
+            int active = players.nearestTo(s.ball.pos);
+            planner.clearActions();
+            planner.addAction({PlanAction::DRIBBLE, players.getPos(active) + Vector(3, 0)});
+            planner.addAction({PlanAction::SHOOT, Vector(field.getWidth(), field.getHeight() / 2)});
+            for (int p = 0; p < players.size(); ++p) {
+                if (p != active) planner.addAction({PlanAction::PASS, players.getPos(p), p});
+            }
+            int choice = planner.choose(s.ball, field, ai.getInfluence(), players, active,
+                                        s.team2.players, true, 0.8f, 1.0f, 64);
+            sink = sink + (float)choice;
+        }
+    }, BY_PLAYERS);
+
+    // One fixed step of a headless AI vs AI match: AI, movement,
+    // collisions and the ball
+    addBenchmark("match_tick", [](State &state) {
+        MatchSimulation sim(makeField(state.range(0)), MODE_AI_VS_AI, 1e6f, state.range(1), 7);
+        MatchInputs none;
+        for (int i = 0; i < 120; ++i) sim.step(MatchSimulation::FIXED_DT, none);
+        while (state.keepRunning()) {
+            sim.step(MatchSimulation::FIXED_DT, none);
+        }
+        sink = sink + sim.getBall().pos.x;
+    }, BY_BOTH);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+static std::map<std::string, double> readResults(const std::string &path) {
+    std::map<std::string, double> results;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        results[line.substr(0, comma)] = std::atof(line.c_str() + comma + 1);
+    }
+    return results;
+}
+
+static void usage(const char *argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--filter TEXT] [--min-time SECONDS] [--out FILE]\n"
+                 "          [--baseline FILE] [--tolerance PERCENT]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    std::string filter, outPath, baselinePath;
+    double minTime = 0.1;
+    double tolerance = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--filter") && hasValue) {
+            filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min-time") && hasValue) {
+            minTime = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--out") && hasValue) {
+            outPath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--baseline") && hasValue) {
+            baselinePath = argv[++i];
+        } else if (!std::strcmp(argv[i], "--tolerance") && hasValue) {
+            tolerance = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty()) {
+        baseline = readResults(baselinePath);
+        if (baseline.empty()) {
+            std::fprintf(stderr, "No results in baseline %s\n", baselinePath.c_str());
+            return 2;
+        }
+    }
+    std::ofstream out;
+    if (!outPath.empty()) {
+        out.open(outPath);
+        if (!out) {
+            std::fprintf(stderr, "Could not write %s\n", outPath.c_str());
+            return 2;
+        }
+    }
+
+    registerBenchmarks();
+    std::printf("%-30s %14s %12s %10s\n", "benchmark", "time (ns)", "iterations",
+                baseline.empty() ? "" : "vs base");
+    int regressions = 0;
+    for (const Benchmark &b : registry()) {
+        for (const std::vector<int> &args : b.argSets) {
+            std::string name = instanceName(b, args);
+            if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+            long long iterations = 0;
+            double ns = measure(b, args, minTime, iterations);
+            std::printf("%-30s %14.1f %12lld", name.c_str(), ns, iterations);
+            auto base = baseline.find(name);
+            if (base != baseline.end() && base->second > 0.0) {
+                double change = (ns / base->second - 1.0) * 100.0;
+                bool slower = change > tolerance;
+                regressions += slower;
+                std::printf(" %+9.1f%%%s", change, slower ? "  REGRESSION" : "");
+            }
+            std::printf("\n");
+            if (out) out << name << ',' << ns << '\n';
+        }
+    }
+
+    if (!baseline.empty()) {
+        if (regressions) {
+            std::printf("%d benchmark(s) slower than the baseline by more than %.0f%%\n",
+                        regressions, tolerance);
+        } else {
+            std::printf("no regressions beyond %.0f%%\n", tolerance);
+        }
+    }
+    return regressions ? 1 : 0;
+}
@@ -4,12 +4,33 @@
 #include "Team.h"
 #include "Ball.h"
 #include "Field.h"
+#include "PlayerStore.h"
+#include "SpatialGrid.h"
+#include "InfluenceMap.h"
+#include "BallPredictor.h"
+#include "RolloutPlanner.h"
+#include "FlowField.h"
+#include <memory>
+#include <vector>
 
 // ============================================================================
 // AI Agent with Active/Support role system, passing logic, and steering behaviors.
 //
-// Active Player : Bot closest to ball or holding ball -> chases/dribbles/passes.
-// Support Player: Other bot -> finds open space for receiving passes.
+// Active Player  : Bot closest to ball or holding ball -> chases/dribbles/passes.
+// Support Players: Every other bot -> finds open space for receiving passes,
+//                  or drops back to defend while the opponents have the
+//                  ball in our half.
+//
+// Opponent and teammate distances, shot angles and obstacle clearance come
+// from the team's InfluenceMap, rebuilt once per step.
+//
+// A player whose way to its target is blocked by an obstacle follows a
+// flow field (Navigator) round it instead of pushing into it.  An agent has
+// a Navigator of its own unless given one to share, as MatchSimulation
+// does with both teams' agents.
+//
+// Players are addressed by index into the team's PlayerStore, so the same
+// code drives teams of any size.
 // ============================================================================
 
 // Possible states for an AI-controlled player
@@ -25,31 +46,83 @@ enum class AIState {
     WAIT_RECEIVE,   // At position, facing ball, ready to receive
 
     // Common
-    DEFEND          // Fall back to defensive position
+    DEFEND          // Fall back between the ball and our goal
+};
+
+// Decision thresholds of the active player.  The defaults are the values
+// the game ships with; sigma_batch sweeps them to evaluate alternatives.
+struct AITuning {
+    // Shooting: the goal mouth must subtend more than the angle (radians)
+    // and the goal be within range (metres).  A good shot is only taken
+    // under pressure, a great one whenever it is available.
+    float goodShotAngle  = 0.15f;
+    float goodShotRange  = 18.0f;
+    float greatShotAngle = 0.30f;
+    float greatShotRange = 12.0f;
+    float shotClearance  = 1.5f;   // opponents this close to the line block it
+
+    // Passing: receivers between min and max distance with a lane this
+    // wide.  A receiver who is not further forward is still used when an
+    // opponent is within pressureDistance and the receiver is beyond
+    // pressurePassDistance.
+    float passMinDistance      = 4.0f;
+    float passMaxDistance      = 25.0f;
+    float passLaneClearance    = 2.5f;
+    float pressureDistance     = 4.0f;
+    float pressurePassDistance = 5.0f;
+
+    // Seconds between consecutive shots / passes
+    float shotCooldown = 2.0f;
+    float passCooldown = 1.5f;
+
+    // With a budget (seconds of wall clock per decision) a RolloutPlanner
+    // chooses between shooting, passing and dribbling instead of the fixed
+    // priority above, running at most planRollouts rollouts.  The choice
+    // then depends on how fast the machine is, so a match is no longer
+    // reproducible from its inputs.
+    float planBudget   = 0.0f;
+    int   planRollouts = 4096;
 };
 
 class AIAgent {
 public:
-    AIAgent(float reaction = 0.8f);
+    AIAgent(float reaction = 0.8f, const AITuning &tuning = AITuning());
 
-    // Main update: controls BOTH players in a team using Active/Support roles.
+    // Main update: controls ALL players in a team using Active/Support roles.
     // Call this ONCE per team per frame (it handles role assignment internally).
     void updateTeam(float dt, Team &team, const Ball &ball, const Field &field,
                     bool isLeftSide, const Team &opponentTeam);
 
-    // Legacy single-player update (kept for backward compatibility)
-    void update(float dt, Player &aiPlayer, const Ball &ball,
+    // Legacy single-player update: drives player `index` of the team
+    // (kept for backward compatibility).  Call updateInfluence() once per
+    // step first, or players off the ball just return to a home spot.
+    void update(float dt, Team &team, int index, const Ball &ball,
                 const Field &field, bool isLeftSide);
 
+    // Rebuild the influence map for this step (updateTeam does it itself).
+    void updateInfluence(const Field &field, bool isLeftSide, const PlayerStore &team,
+                         const PlayerStore &opponents);
+    const InfluenceMap &getInfluence() const { return influence; }
+
+    // Share flow fields with other agents (both teams of a match).
+    void setNavigator(const std::shared_ptr<Navigator> &shared) { navigator = shared; }
+
     // ---- Getters for debug / rendering ----
     AIState getActiveState()  const { return activeState; }
     AIState getSupportState() const { return supportState; }
     bool    didJustPass()     const { return justPassed; }
     bool    didJustShoot()    const { return justShot; }
     Vector  getShotTarget()   const { return shotTarget; }
+    int     getPassReceiver() const { return passReceiver; }
+    float   getReaction()     const { return reactionSpeed; }
+    const AITuning &getTuning() const { return tuning; }
 
 private:
+    // sigma_bench times the search helpers directly
+    friend struct AIAgentBench;
+
     float reactionSpeed;
+    AITuning tuning;
 
     // Internal state tracking
     AIState activeState;
@@ -57,27 +130,40 @@ private:
     bool    justPassed;       // flag set for one frame after a pass
     bool    justShot;         // flag set for one frame after a shot
     Vector  shotTarget;       // where the shot is aimed
+    int     passReceiver;     // teammate index the last pass went to
     float   passCooldown;     // seconds until next pass allowed
     float   shotCooldown;     // seconds until next shot allowed
     float   possessionTimer;  // how long active bot has been near ball
+    InfluenceMap influence;   // this team's view of the pitch this step
+    BallPredictor predictor;  // the ball's path, for the chasing player
+    RolloutPlanner planner;   // the player on the ball's options, if planning
+    std::shared_ptr<Navigator> navigator;   // ways round the obstacles
 
     // ---- Role Assignment ----
-    // Returns index (0 or 1) indicating which player should be Active.
+    // Returns the index of the player that should be Active.
     int assignRoles(const Team &team, const Ball &ball) const;
 
     // ---- Active Player behaviors ----
-    void updateActive(float dt, Player &active, Player &support,
+    void updateActive(float dt, PlayerStore &players, int active,
                       const Ball &ball, const Field &field,
-                      bool isLeftSide, const Team &opponentTeam);
+                      bool isLeftSide, const PlayerStore &opponents);
+
+    // Decide on the ball with the RolloutPlanner (tuning.planBudget > 0).
+    void planActive(float dt, PlayerStore &players, int active,
+                    const Ball &ball, const Field &field,
+                    bool isLeftSide, const PlayerStore &opponents);
 
-    void chaseBall(float dt, Player &player, const Ball &ball,
+    void chaseBall(float dt, PlayerStore &players, int i, const Ball &ball,
                    const Field &field, bool isLeftSide);
 
-    void dribble(float dt, Player &player, const Ball &ball,
-                 const Field &field, bool isLeftSide);
+    // Where a dribbling player at pos heads for.
+    Vector dribbleTarget(const Vector &pos, const Field &field, bool isLeftSide) const;
+
+    void dribble(float dt, PlayerStore &players, int i, const Field &field,
+                 bool isLeftSide);
 
     // Performs the pass: applies force to ball velocity.
-    void executePass(Ball &ball, const Player &passer, const Player &receiver);
+    void executePass(Ball &ball, const Vector &receiverPos);
 
     // ---- Shooting logic ----
     // Calculate the shooting angle subtended by the goal opening from a position.
@@ -85,49 +171,128 @@ private:
     float calculateShootingAngle(const Vector &shooterPos, const Field &field,
                                  bool isLeftSide) const;
 
-    // Check if a shot can reach the goal without being blocked by opponents.
-    bool isShotClear(const Vector &from, const Vector &target,
-                     const Team &opponentTeam, float clearance = 1.5f) const;
+    // Check if a shot can reach the goal without being blocked by opponents
+    // or obstacles.
+    bool isShotClear(const Vector &from, const Vector &target, const Field &field,
+                     const PlayerStore &opponents, float clearance = 1.5f) const;
 
-    // Find the best point within the goal to shoot at (maximises gap from opponents).
+    // Find the best point within the goal to shoot at (maximises gap from
+    // opponents; targets hidden behind obstacles are skipped).
     Vector findBestShotTarget(const Vector &shooterPos, const Field &field,
-                              bool isLeftSide, const Team &opponentTeam) const;
+                              bool isLeftSide, const PlayerStore &opponents) const;
+
+    // ---- Defending ----
+    // How many supporters should drop back this step (0 unless the
+    // opponents are on the ball in our half with the way to goal open).
+    int defendersNeeded(int supporters, const Ball &ball, const Field &field,
+                        bool isLeftSide) const;
+
+    // Move a supporter to the influence map's defensive spot and add it
+    // to spacing.
+    void updateDefender(float dt, PlayerStore &players, int i,
+                        std::vector<Vector> &spacing, const Ball &ball,
+                        const Field &field);
 
     // ---- Support Player behaviors ----
-    void updateSupport(float dt, Player &support, const Player &active,
-                       const Ball &ball, const Field &field,
-                       bool isLeftSide, const Team &opponentTeam);
+    // `spacing` holds the active player's position and the targets already
+    // picked by other supporters this frame, so supporters spread out.
+    void updateSupport(float dt, PlayerStore &players, int support,
+                       std::vector<Vector> &spacing, const Ball &ball,
+                       const Field &field, bool isLeftSide,
+                       const PlayerStore &opponents);
 
     // Find the optimal receiving position (open, with clear passing lane).
-    Vector findOptimalReceivingPoint(const Player &support, const Player &active,
-                                    const Ball &ball, const Field &field,
-                                    bool isLeftSide, const Team &opponentTeam) const;
+    // Searches a 0.5 m grid coarse-to-fine using receivingGrid.
+    Vector findOptimalReceivingPoint(const Vector &supportPos,
+                                     const std::vector<Vector> &spacing,
+                                     const Ball &ball, const Field &field,
+                                     bool isLeftSide, const PlayerStore &opponents);
+
+    // ---- Receiving point cache ----
+    // One candidate spot of the receiving-point search.
+    struct ReceivingCell {
+        bool   standable;     // clear of obstacles
+        float  staticScore;   // advance + centrality + shooting angle
+        int    laneSnapshot;  // snapshot laneOppDist was measured in, -1 = none
+        float  laneOppDist;   // opponents' distance to the ball->cell lane then
+        bool   losTested;
+        bool   losClear;      // ball->cell line of sight past obstacles
+        Vector losBall;       // ball position losClear was tested from
+    };
+
+    // Candidate spots on a 0.5 m grid with the terms that depend only on
+    // the field and side computed once, plus the lane terms of the last
+    // evaluation.  Lane terms are measured against a snapshot of the ball
+    // and opponents and reused while everything has moved too little to
+    // change the clear / blocked decision.
+    struct ReceivingGrid {
+        uint32_t revision = 0;          // layout the static terms belong to
+        float  width = 0.0f;
+        float  height = 0.0f;
+        bool   isLeftSide = false;
+        int    cols = 0;
+        int    rows = 0;
+        std::vector<ReceivingCell> cells;   // row-major
+
+        int         snapshot = 0;      // bumped whenever the snapshot is retaken
+        Vector      snapBall;
+        PlayerStore snapOpponents;
+    };
+    ReceivingGrid receivingGrid;
+
+    // (Re)build the static terms if the field or side changed.
+    void prepareReceivingGrid(const Field &field, bool isLeftSide);
+
+    // Retake the lane snapshot if the ball and opponents drifted too far
+    // from it; returns how far they have drifted (metres) otherwise.
+    float updateLaneSnapshot(const Ball &ball, const PlayerStore &opponents);
+
+    // Measure the opponent lane term of the listed cells that are not
+    // current for this snapshot, as one batch.
+    void refreshReceivingLanes(const std::vector<int> &cellIds);
+
+    // Full score of one grid cell (-1e30 if nobody can stand there).
+    // Its lane term must have been refreshed first.
+    float scoreReceivingCell(int col, int row, float drift,
+                             const std::vector<Vector> &spacing, const Ball &ball,
+                             const Field &field, const PlayerStore &opponents);
 
     // ---- Utility helpers ----
-    // Checks if the passing lane between two points is clear of opponents.
-    bool isPassingLaneClear(const Vector &from, const Vector &to,
-                            const Team &opponentTeam, float clearance = 2.0f) const;
+    // Checks if the passing lane between two points is clear of opponents
+    // and has line of sight past the obstacles.
+    bool isPassingLaneClear(const Vector &from, const Vector &to, const Field &field,
+                            const PlayerStore &opponents, float clearance = 2.0f) const;
+
+    // Smallest distance from any opponent to the segment from-to.
+    float minOpponentDistanceToSegment(const Vector &from, const Vector &to,
+                                       const PlayerStore &opponents) const;
 
-    // Steer a player toward a target with arrival slowdown.
-    void seekWithArrival(float dt, Player &player, const Vector &target,
-                         float slowRadius = 3.0f) const;
+    // Steer a player toward a target with arrival slowdown, round any
+    // obstacle in the way.
+    void seekWithArrival(float dt, PlayerStore &players, int i, const Vector &target,
+                         const Field &field, float slowRadius = 3.0f);
 
     // Clamp player inside field boundaries.
-    void clampToField(Player &player, const Field &field) const;
+    void clampToField(PlayerStore &players, int i, const Field &field) const;
 
     // Check if player is "possessing" the ball (within contact distance).
-    bool hasPossession(const Player &player, const Ball &ball) const;
-
-    // Calculate distance from a point to a line segment (for lane clearance).
-    float pointToSegmentDistance(const Vector &point, const Vector &segA,
-                                const Vector &segB) const;
+    bool hasPossession(const PlayerStore &players, int i, const Ball &ball) const;
 };
 
 // ============================================================================
 // Player-to-Player collision resolution (call after all movement each frame).
 // Resolves overlapping players by pushing them apart along the collision normal.
 // ============================================================================
-void resolvePlayerCollisions(Player &a, Player &b);
+// All pairs within one team.
+void resolvePlayerCollisions(PlayerStore &players);
+
+// All pairs with one player from each team.
+void resolvePlayerCollisions(PlayerStore &a, PlayerStore &b);
 
-// Convenience: resolve all pairs among 4 players.
+// Convenience: resolve every pair among the players of both teams.
 void resolveAllPlayerCollisions(Team &team1, Team &team2);
+
+// Same pairs in the same order, but only those the broadphase grid reports
+// as close.  grid files team 1 player i under id i and team 2 player j under
+// team1.size() + j; it is brought up to date with the current positions here.
+void resolveAllPlayerCollisions(Team &team1, Team &team2, SpatialGrid &grid);
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <SDL.h>
+#include "FontAtlas.h"
+#include "SpriteAtlas.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A sprite image and the largest size it is kept at in the atlas.
+struct SpriteFile {
+    Sprite id;
+    std::string path;
+    int maxSize;
+};
+
+// ============================================================================
+// Background asset loading.
+//
+// Fonts and sprite images are decoded on one loader thread (SDL_image /
+// SDL_ttf work and all CPU-side rasterizing, scaling and packing) into
+// staging atlases that only hold pixels in system memory.  update(), called
+// once per frame on the render thread, uploads the finished ones to the GPU
+// a band of rows at a time within a time budget and then swaps them into
+// the handles everybody holds, so no frame stalls on a decode or on a big
+// upload.
+//
+// Fonts are reference-counted handles shared by everyone asking for the
+// same (path, size): the HUD and the menus draw from the same atlas.  A
+// handle is valid at once and draws nothing until its atlas is ready.
+// Font requests are served before the sprite atlas, so menus get their
+// text first.
+//
+// The loader thread is the only user of SDL_ttf and SDL_image while it
+// runs; TTF_Init() and IMG_Init() must be done before start().
+// ============================================================================
+class AssetManager {
+public:
+    AssetManager();
+    ~AssetManager();
+    AssetManager(const AssetManager &) = delete;
+    AssetManager &operator=(const AssetManager &) = delete;
+
+    // Start the loader thread; textures are created on renderer.
+    void start(SDL_Renderer *renderer);
+    // Stop the thread and destroy every texture, including those behind
+    // handles still held elsewhere.  Call before the renderer goes away.
+    void stop();
+
+    // Shared atlas for a font file at a point size, loaded in the
+    // background on first request.  Null only before start().
+    std::shared_ptr<FontAtlas> font(const std::string &path, int pointSize);
+
+    // Decode the files, add the procedural shapes and pack them into the
+    // sprite atlas in the background.
+    void loadSprites(const std::vector<SpriteFile> &files);
+    // Empty (has() is false for everything) until loaded.
+    const SpriteAtlas &getSprites() const { return sprites; }
+
+    // Upload finished work for at most budgetMs milliseconds.  Call once
+    // per frame on the render thread.
+    void update(double budgetMs = UPLOAD_BUDGET_MS);
+
+    // Nothing waiting to be decoded or uploaded.
+    bool isIdle() const { return finished == requested; }
+    // Finished requests over all requests so far, in [0, 1].
+    float getProgress() const;
+
+    // Drop loaded fonts nobody holds a handle to any more.
+    void purgeUnused();
+
+private:
+    static constexpr double UPLOAD_BUDGET_MS = 4.0;
+    // Rows uploaded between budget checks
+    static const int ROWS_PER_SLICE = 32;
+
+    // Decoded, waiting for (or in the middle of) its upload.
+    struct Staged {
+        std::shared_ptr<FontAtlas> target;      // font handle to publish to
+        std::unique_ptr<FontAtlas> font;        // null if decoding failed
+        std::unique_ptr<SpriteAtlas> sprites;   // for the sprite atlas
+    };
+
+    SDL_Renderer *renderer;
+    std::thread worker;
+
+    // Shared with the loader thread
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> fontJobs;    // served first
+    std::deque<std::function<void()>> bulkJobs;
+    std::deque<Staged> ready;
+    bool stopping;
+
+    // Render thread only
+    std::map<std::pair<std::string, int>, std::shared_ptr<FontAtlas>> fonts;
+    SpriteAtlas sprites;
+    int requested;
+    int finished;
+
+    void run();
+    void post(std::function<void()> job, bool font);
+    void publish(Staged &staged);
+    // Upload one slice of staged; returns true once it is done (or failed).
+    bool uploadSlice(Staged &staged);
+};
@@ -3,7 +3,10 @@
 #include "Vector.h"
 
 class Field; // forward declaration so Ball can reference it without including
-class Player; // forward declaration
+class PlayerStore; // forward declaration
+class ShapeBatch; // forward declaration
+class Camera; // forward declaration
+class SpriteAtlas; // forward declaration
 
 // Simple moving ball for the hockey field.  Position and velocity are stored in
 // metres and metres/second.  The radius is also in metres.
@@ -15,19 +18,33 @@ public:
          const Vector& startVel = Vector(),
          float r = 0.5f);
 
-    // advance the ball by dt seconds with friction
+    // advance the ball by dt seconds with friction (no collision checks;
+    // MatchSimulation moves the ball with Field::moveBall instead)
     void update(float dt);
 
-    // check collision with a player and bounce off
-    void handlePlayerCollision(const Player& player, float playerRadius);
+    // slow the ball down for a step of dt seconds
+    void applyFriction(float dt);
 
-    // draw the ball using the same scaling logic as the field for
-    // consistency.  If a texture is provided it will be drawn centred at the
-    // ball's screen position and scaled to its radius. Otherwise the ball is
-    // rendered as a filled circle.
-    void render(SDL_Renderer* renderer, const Field& field,
-                int screenW, int screenH,
-                SDL_Texture *texture = nullptr) const;
+    // check collision with a player (circle) and bounce off
+    void handlePlayerCollision(const Vector& playerPos, float playerRadius);
+
+    // velocity response to touching a player; normal points from the player
+    // towards the ball
+    void bounceOffPlayer(const Vector& normal);
+
+    // reflect the velocity component going into a surface (normal points
+    // away from the surface), keeping `restitution` of it
+    void bounce(const Vector& normal, float restitution);
+
+    // check collision against every player of a team, in index order
+    void handlePlayerCollisions(const PlayerStore& players);
+
+    // draw the ball through the same camera as the field for
+    // consistency.  If the atlas has a BALL sprite it is drawn centred at
+    // the ball's screen position and scaled to its radius. Otherwise the
+    // ball is rendered as a filled circle.
+    void render(ShapeBatch &batch, const Camera &camera,
+                const SpriteAtlas *sprites = nullptr) const;
 
     // Reset ball to center of field with given velocity
     void reset(const Vector& centerPos, const Vector& startVel = Vector());
@@ -35,5 +52,5 @@ public:
     Vector pos;        // position in metres
     Vector vel;        // velocity in metres per second
     float radius;      // metres
-    float friction;    // deceleration factor
+    float friction;    // fraction of velocity kept per 1/60 s
 };
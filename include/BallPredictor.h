@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Vector.h"
+#include <vector>
+
+class Ball;
+class Field;
+
+// ---------------------------------------------------------------------------
+// Closed-form ball trajectory.
+//
+// Between bounces the ball moves in a straight line while MatchSimulation
+// multiplies its velocity by k = (friction * 0.95)^(60 dt) every step, so
+// after n steps it has travelled v0 dt (1 - k^n) / (1 - k) and stops for
+// good once its speed drops below 0.1 m/s.  predict() inverts that for the
+// distance to the next wall or obstacle (walls analytically, obstacles by
+// sphere tracing the field's distance field), reflects the velocity with
+// the restitution the simulation uses and carries on, giving the path as a
+// few segments.  Players are ignored: they move.
+//
+// Positions at any time and the earliest point a player can reach the
+// ball are then answered from the segments in closed form, without
+// stepping the ball at all.
+// ---------------------------------------------------------------------------
+class BallPredictor {
+public:
+    // Bounces followed before the path is cut short.
+    static const int MAX_BOUNCES = 8;
+
+    // Trace the path of ball from now, for steps of stepDt seconds.
+    void predict(const Ball &ball, const Field &field, float stepDt);
+
+    // Ball centre t seconds from now (t >= 0).  After a goal the ball is
+    // held where it crossed the line.
+    Vector positionAt(float t) const;
+    // Speed (m/s) t seconds from now.
+    float speedAt(float t) const;
+
+    // Seconds until the ball stops (or is cut short / scores).
+    float getEndTime() const { return segments.empty() ? 0.0f : segments.back().tEnd; }
+    // Where it ends up.
+    Vector getEndPoint() const { return positionAt(getEndTime()); }
+    // 0 = stays on the pitch, 1 = into the left goal, 2 = into the right one.
+    int getGoal() const { return goal; }
+
+    // Earliest time a player at `from` running at `speed` can be within
+    // `reach` of the ball's centre, and the ball's position then.  Returns
+    // false if the ball goes into a goal first.
+    bool intercept(const Vector &from, float speed, float reach,
+                   float &time, Vector &point) const;
+
+private:
+    // Straight run between two bounces.
+    struct Segment {
+        float  t0;      // seconds from now at the start
+        float  tEnd;    // ... and at the end
+        Vector p0;      // start point
+        Vector dir;     // unit direction
+        float  v0;      // speed at the start
+        float  length;  // metres travelled by tEnd
+    };
+
+    std::vector<Segment> segments;
+    float stepDt = 1.0f / 120.0f;
+    float logK = 0.0f;    // ln of the per-step velocity factor
+    int goal = 0;
+
+    const Segment &segmentAt(float t) const;
+    // Distance along a segment after tau seconds, and its inverse (-1 if
+    // the segment never gets that far).
+    float distanceAfter(const Segment &s, float tau) const;
+    float timeToTravel(float v0, float dist) const;
+};
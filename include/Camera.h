@@ -0,0 +1,97 @@
+#pragma once
+
+#include <SDL.h>
+#include "Vector.h"
+
+class Field;
+
+// How the camera chooses what it looks at.
+enum class CameraMode {
+    FIXED,        // stays on its centre (the pitch centre unless panned)
+    FOLLOW_BALL   // glides after the ball, never showing past the pitch
+};
+
+// ============================================================================
+// World-to-screen transform shared by all render code.
+//
+// frame() works out where the pitch sits on screen once per frame: at zoom
+// 1 it is fitted exactly as before (95% of the window width, 2:1, at the
+// bottom of the window); zoom and the camera centre scale and move that
+// picture.  Everything drawn in world coordinates then maps points through
+// the same scale and offset instead of recomputing the viewport per call.
+// ============================================================================
+class Camera {
+public:
+    static constexpr float MIN_ZOOM = 1.0f;
+    static constexpr float MAX_ZOOM = 4.0f;
+
+    Camera();
+
+    // Camera that maps the whole pitch exactly onto rect (zoom 1), e.g. to
+    // draw into a texture.
+    static Camera fitTo(const Field &field, const SDL_FRect &rect);
+
+    // Recompute the transform for this frame.
+    void frame(const Field &field, int screenW, int screenH);
+
+    // Move the centre towards target (FOLLOW_BALL only), reaching it
+    // smoothly over roughly FOLLOW_TIME seconds.
+    void follow(const Vector &target, float dt);
+
+    void setMode(CameraMode m) { mode = m; }
+    CameraMode getMode() const { return mode; }
+
+    // Zoom factor, clamped to [MIN_ZOOM, MAX_ZOOM].  At MIN_ZOOM the whole
+    // pitch is always shown.
+    void setZoom(float z);
+    float getZoom() const { return zoom; }
+
+    // Shift the centre by delta metres.
+    void pan(const Vector &delta);
+    // Back to the whole pitch, FIXED.
+    void reset();
+
+    // ---- Transform (valid after frame()) ----
+    SDL_FPoint worldToScreen(float x, float y) const {
+        return SDL_FPoint{offsetX + x * scaleX, offsetY + y * scaleY};
+    }
+    SDL_FPoint worldToScreen(const Vector &p) const { return worldToScreen(p.x, p.y); }
+
+    // Screen rectangle of the world box at (x, y) sized w x h metres.
+    SDL_FRect worldRect(float x, float y, float w, float h) const {
+        return SDL_FRect{offsetX + x * scaleX, offsetY + y * scaleY, w * scaleX, h * scaleY};
+    }
+    // The pitch (0,0)-(width,height) on screen.
+    SDL_FRect getPitchRect() const { return pitch; }
+
+    float getScaleX() const { return scaleX; }   // pixels per metre
+    float getScaleY() const { return scaleY; }
+    // A length in metres as pixels (uniform, so circles stay round).
+    float pixels(float metres) const { return metres * (scaleX < scaleY ? scaleX : scaleY); }
+
+    int getScreenWidth() const { return screenW; }
+    int getScreenHeight() const { return screenH; }
+
+    // Transform n positions given as coordinate arrays (e.g. PlayerStore's
+    // x and y) into screen coordinate arrays, four at a time where SSE2 is
+    // available.
+    void transform(const float *x, const float *y, int n, float *outX, float *outY) const;
+
+private:
+    static constexpr float FOLLOW_TIME = 0.25f;
+
+    CameraMode mode;
+    float zoom;
+    Vector centre;       // world point shown at the middle of the pitch area
+    bool centred;        // centre not chosen yet; use the pitch centre
+
+    // frame() results
+    int screenW, screenH;
+    float scaleX, scaleY;
+    float offsetX, offsetY;
+    SDL_FRect pitch;
+    Vector fieldSize;
+
+    // Keep the view inside the pitch when zoomed in.
+    void clampCentre();
+};
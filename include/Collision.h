@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Vector.h"
+
+// ---------------------------------------------------------------------------
+// Swept (continuous) collision tests for a moving circle.
+//
+// The circle starts at `start` and travels `move` over the step.  A test
+// reports the first time of impact t in [0, 1] (fraction of move) and the
+// contact normal pointing from the obstacle towards the circle.  Because
+// the whole path is tested, a fast ball cannot skip over thin walls the
+// way a position check at the end of the step can.
+//
+// A circle that already overlaps the shape and is moving further in
+// reports t = 0; one that overlaps but is moving out reports no hit, so it
+// is free to leave.
+// ---------------------------------------------------------------------------
+struct SweepHit {
+    float  t;        // time of impact as a fraction of move (0..1)
+    Vector normal;   // unit contact normal, pointing towards the circle
+};
+
+// Moving circle against an axis-aligned box.
+bool sweepCircleVsAABB(const Vector &start, const Vector &move, float radius,
+                       float minX, float minY, float maxX, float maxY,
+                       SweepHit &hit);
+
+// Moving circle against a stationary circle.
+bool sweepCircleVsCircle(const Vector &start, const Vector &move, float radius,
+                         const Vector &centre, float otherRadius,
+                         SweepHit &hit);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Vector.h"
+#include <vector>
+
+class Obstacle;
+
+// ---------------------------------------------------------------------------
+// Baked signed distance field of the static obstacles.
+//
+// Distance to the nearest obstacle outline (negative inside one) and its
+// gradient are sampled on a regular grid of nodes once, when obstacles are
+// added, and read back with bilinear interpolation.  Every query is then a
+// constant-time lookup whatever the obstacle shapes are.
+//
+// Distances are truncated at maxDistance: each obstacle only touches nodes
+// within that range of its bounds, so adding one is cheap, and anything
+// farther away simply reads as "at least maxDistance".
+// ---------------------------------------------------------------------------
+class DistanceField {
+public:
+    // Covers [minX, maxX] x [minY, maxY] with nodes cellSize apart.
+    DistanceField(float minX = 0.0f, float minY = 0.0f,
+                  float maxX = 40.0f, float maxY = 20.0f,
+                  float cellSize = 0.1f, float maxDistance = 4.0f);
+
+    // Fold an obstacle into the field (union with what is already there).
+    void addObstacle(const Obstacle &obs);
+
+    // Signed distance to the nearest obstacle at p.  Points outside the
+    // baked area use the nearest edge node plus the distance to it.
+    float distance(const Vector &p) const;
+
+    // Unit direction in which the distance grows fastest at p (points out
+    // of obstacles).  Zero where no obstacle is within maxDistance.
+    Vector gradient(const Vector &p) const;
+
+    float getMaxDistance() const { return maxDistance; }
+    float getCellSize() const { return cellSize; }
+
+private:
+    float minX, minY;
+    float cellSize;
+    float invCellSize;
+    float maxDistance;
+    int cols, rows;   // node counts
+
+    std::vector<float> dist;   // row-major, cols x rows nodes
+    std::vector<float> gradX;
+    std::vector<float> gradY;
+
+    // Cell containing p (clamped to the grid) and the position inside it.
+    void locate(const Vector &p, int &i, int &j, float &fx, float &fy) const;
+};
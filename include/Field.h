@@ -1,42 +1,102 @@
 #pragma once
 
 #include <SDL.h>
+#include <cstdint>
+#include <memory>
 #include <vector>
+#include "Vector.h"
+#include "DistanceField.h"
 
 class Ball; // forward
-class Player; // forward declaration for player collision
+class PlayerStore; // forward declaration for player collision
 class Obstacle; // forward declaration for obstacles
+class ShapeBatch;
+class Camera;
+class SpriteAtlas;
+struct SweepHit;
 
 // Represents a rectangular hockey field with boundary barriers and goal zones.
 // The field dimensions are specified in metres; rendering is scaled to the
 // current window resolution so that the entire field always fits on screen.
 class Field {
 public:
+    // Clearance a pass or shot needs around obstacles (the ball's radius),
+    // and distance from obstacles a player needs to stand at a spot; the
+    // AI's line-of-sight and positioning tests all use these.
+    static constexpr float BALL_CLEARANCE = 0.5f;
+    static constexpr float STAND_CLEARANCE = 1.0f;
+
+    // Fraction of its speed into a wall or obstacle the ball keeps when it
+    // bounces off.
+    static constexpr float WALL_RESTITUTION = 0.75f;
+    static const int WALL_BOXES = 6;
+
     // width_m and height_m are real-world dimensions in metres (40x20 by default).
     Field(float width_m = 40.0f, float height_m = 20.0f);
 
-    // Draw the field background and border using the provided renderer and
-    // current window size. If a non-null texture is supplied it will be
-    // stretched to cover the entire window; otherwise a solid colour with a
-    // border is drawn. Also draws goal zones and center line.
-    void render(SDL_Renderer* renderer, int screenW, int screenH,
-                SDL_Texture *texture = nullptr) const;
+    // Draw the field background and border where the camera shows the
+    // pitch. If the atlas has a FIELD sprite it is stretched to cover the
+    // pitch; otherwise a solid colour with a border is drawn.
+    // Also draws goal zones and center line.
+    void render(ShapeBatch &batch, const Camera &camera,
+                const SpriteAtlas *sprites = nullptr) const;
 
     // Check a ball against the four walls and reflect its velocity if it
     // intersects a barrier (except in goal zones).
     // Returns: 0 = no goal, 1 = left goal (team2 scores), 2 = right goal (team1 scores)
     int handleCollision(Ball& ball) const;
 
+    // Move the ball along its velocity for dt seconds with continuous
+    // collision detection against the walls, goal boxes, obstacles and the
+    // players of both teams.  The ball travels to the earliest impact,
+    // bounces, and carries on with the time left, so it cannot tunnel at
+    // any speed.  Returns the same goal codes as handleCollision.
+    int moveBall(Ball& ball, float dt, const PlayerStore &team1,
+                 const PlayerStore &team2) const;
+
+    // The walls as solid boxes (minX, minY, maxX, maxY) around the pitch,
+    // as moveBall sweeps the ball against them.  The side walls stop at the
+    // goal posts, which leaves the goal mouths open; the inside of each
+    // goal box is bounded by the same boxes.
+    void wallBoxes(float boxes[WALL_BOXES][4]) const;
+
+    // Sphere-trace a circle of radius r along move through the distance
+    // field; fills hit with the first contact, if any (moveBall's obstacle
+    // test).  A move that grazes a surface for too long is stopped short.
+    bool sweepObstacles(const Vector &start, const Vector &move, float r,
+                        SweepHit &hit) const;
+
     float getWidth() const { return width; }
     float getHeight() const { return height; }
 
     // add an obstacle to the field geometry; obstacles are considered during
-    // collision checks and rendered on top of the grass.
+    // collision checks and rendered on top of the grass.  The obstacle is
+    // baked into the field's signed distance field here, once.
     void addObstacle(const Obstacle &obs);
     const std::vector<Obstacle> &getObstacles() const { return obstacles; }
 
-    // resolve a player overlapping any obstacle (called by the game loop)
-    void handlePlayerCollision(Player &player) const;
+    // Identifies the field's geometry: changes whenever an obstacle is
+    // added and is never shared by two different layouts, so caches of the
+    // drawn field or of anything else worked out from the layout can key
+    // on it.
+    uint32_t getRevision() const { return revision; }
+
+    // Signed distance from p to the nearest obstacle (negative inside one),
+    // read from the baked distance field.  Saturates a few metres away from
+    // any obstacle.
+    float obstacleDistance(const Vector &p) const { return sdf->distance(p); }
+
+    // Unit direction pointing away from the nearest obstacle at p.
+    Vector obstacleGradient(const Vector &p) const { return sdf->gradient(p); }
+
+    // True if a circle of radius `clearance` can travel in a straight line
+    // from a to b without touching an obstacle (line of sight for passes
+    // and shots).
+    bool isPathClear(const Vector &a, const Vector &b, float clearance) const;
+
+    // push every player of a team out of any obstacle it overlaps
+    // (called by the game loop)
+    void handlePlayerCollisions(PlayerStore &players) const;
 
     // Goal zone dimensions (in metres)
     float getGoalTop() const { return height / 2.0f - goalHeight / 2.0f; }
@@ -44,13 +104,9 @@ public:
     float getGoalDepth() const { return goalDepth; }
     float getGoalHeight() const { return goalHeight; }
 
-    // Transform from field world-space into the rectangle where the field is
-    // actually drawn. The viewport is used by rendering routines for players
-    // and the ball so they stay inside the pitch rather than the whole window.
-    SDL_Rect getViewport(int screenW, int screenH) const;
-    // convert a world coordinate to screen pixels
-    SDL_FPoint worldToScreen(float worldX, float worldY, int screenW, int screenH) const;
-
+    // Angle (radians) the goal mouth on the line x = goalX subtends from p;
+    // the larger, the easier the shot.
+    float goalAngle(const Vector &p, float goalX) const;
 
 private:
     float width;   // metres
@@ -60,4 +116,8 @@ private:
 
     // static obstacles on the pitch
     std::vector<Obstacle> obstacles;
+    // baked distance field of the obstacles; shared between copies of the
+    // field and copied only when an obstacle is added to a shared one
+    std::shared_ptr<DistanceField> sdf;
+    uint32_t revision;
 };
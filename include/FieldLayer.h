@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+
+class Camera;
+class Field;
+class ShapeBatch;
+class SpriteAtlas;
+
+// ============================================================================
+// Cached static field layer.
+//
+// The pitch background, lines, goal boxes and obstacles never change during
+// a match, so they are drawn once into a render-target texture the size the
+// pitch has on screen, and every frame copies that texture to wherever the
+// camera shows the pitch; panning costs nothing.  The layer is redrawn when
+// its on-screen size (window size or zoom), the field's geometry
+// (Field::getRevision()), the sprite atlas texture or the renderer changes,
+// or after invalidate().
+//
+// The texture belongs to the renderer: release() it before the renderer is
+// destroyed, and invalidate() it when SDL reports that render targets were
+// lost (SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET).
+// ============================================================================
+class FieldLayer {
+public:
+    FieldLayer();
+    ~FieldLayer();
+    FieldLayer(const FieldLayer &) = delete;
+    FieldLayer &operator=(const FieldLayer &) = delete;
+
+    // Queue the field on batch, redrawing the cached layer first if needed.
+    // Falls back to drawing the field directly if the renderer has no
+    // render-target support.
+    void render(ShapeBatch &batch, const Field &field, const Camera &camera,
+                const SpriteAtlas *sprites = nullptr);
+
+    // Redraw on next use.
+    void invalidate() { valid = false; }
+    // Destroy the texture.
+    void release();
+
+private:
+    SDL_Renderer *renderer;   // owner of layer
+    SDL_Texture *layer;
+    int width, height;
+    uint32_t revision;
+    SDL_Texture *background;  // atlas page the background came from
+    bool valid;
+    bool unsupported;         // creating a target failed; draw directly
+
+    bool rebuild(ShapeBatch &batch, const Field &field, int w, int h,
+                 const SpriteAtlas *sprites);
+};
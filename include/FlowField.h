@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Vector.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class Field;
+
+// ---------------------------------------------------------------------------
+// Obstacle-aware navigation.
+//
+// A FlowField holds, for every node of a grid CELL metres apart over the
+// pitch, the length of the shortest 8-connected path from the node to one
+// target node, found with Dijkstra's algorithm.  Nodes closer to an
+// obstacle than the player radius (the obstacles inflated by it, read from
+// the field's distance field) cost BLOCKED_COST times as much to cross, so
+// paths go round obstacles but a player already touching one can still
+// get away from it.  A player anywhere on the pitch finds its way by
+// walking downhill.
+//
+// The blocked mask only depends on the layout and the radius; moving the
+// target to another node only reruns the search.
+// ---------------------------------------------------------------------------
+class FlowField {
+public:
+    static constexpr float CELL = 1.0f;
+    static constexpr float BLOCKED_COST = 20.0f;
+
+    // Nearest node to p, clamped to the pitch.
+    static int nodeOf(const Field &field, const Vector &p);
+
+    void build(const Field &field, float radius, int targetNode);
+
+    // True if built for exactly this layout, radius and target.
+    bool isFor(const Field &field, float radius, int targetNode) const;
+
+    // Path length from p's node to the target (metres, crossing blocked
+    // nodes counted at their cost).
+    float distance(const Vector &p) const;
+
+    // Where to head for from p: the furthest of the next few nodes
+    // downhill that a circle of radius can reach in a straight line (the
+    // next node if none can).  The target's node itself once there.
+    Vector waypoint(const Field &field, const Vector &p) const;
+
+private:
+    // Layout the mask belongs to
+    uint32_t revision = 0;
+    float width = 0.0f;
+    float height = 0.0f;
+    float radius = -1.0f;
+
+    int cols = 0;
+    int rows = 0;
+    int target = -1;
+    std::vector<uint8_t> blocked;   // row-major, cols x rows nodes
+    std::vector<float> cost;        // path length to target
+
+    Vector nodePos(int node) const { return Vector((node % cols) * CELL, (node / cols) * CELL); }
+    int nodeAt(const Vector &p) const;
+    int lowestNeighbour(int node) const;
+};
+
+// ---------------------------------------------------------------------------
+// The flow fields the players of a match are using.
+//
+// One Navigator serves both teams.  A field is keyed by the node of a
+// coarser lattice (KEY_SPACING grid nodes apart) nearest its target that a
+// player can stand on and see the target from, so every player heading for
+// roughly the same place (the ball, a goal, neighbouring receiving spots)
+// shares one; the player follows it until the target itself is in sight.
+// A field is rebuilt only when its key moves to another lattice node, and
+// the least recently used one makes way for a new key.  Players that can
+// see their target go straight at it without touching a field at all.
+//
+// steer() may be called from both teams' AI threads at once.
+// ---------------------------------------------------------------------------
+class Navigator {
+public:
+    static const int MAX_FIELDS = 16;
+    static const int KEY_SPACING = 4;
+
+    // Point a player of the given radius at from should move towards on
+    // its way to target.
+    Vector steer(const Field &field, const Vector &from, const Vector &target, float radius);
+
+    // Flow fields built so far.
+    int getBuilds() const { return builds.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        FlowField flow;
+        uint64_t lastUsed = 0;
+    };
+    std::mutex mutex;   // guards the slots
+    Slot slots[MAX_FIELDS];
+    uint64_t uses = 0;
+    std::atomic<int> builds{0};
+
+    // Node the field for a player of radius heading for target is built to.
+    static int keyNode(const Field &field, const Vector &target, float radius);
+};
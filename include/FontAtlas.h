@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Glyph atlas text rendering.
+//
+// load() rasterizes the printable ASCII glyphs of one (font, size) once, in
+// white, into a single texture page and keeps their metrics.  Strings are
+// then laid out from the cached metrics and queued as tinted quads; flush()
+// submits everything queued since the last flush in one draw call, so a
+// whole menu or HUD costs one SDL_RenderGeometry per font instead of a
+// surface, a texture upload and a copy per string.
+//
+// Queued text is drawn when flush() runs, so flush before presenting (or
+// before drawing anything that should cover the text).
+//
+// Loading can be split: rasterize() does all the font work on the CPU and
+// needs no renderer, so it can run on a loader thread (as long as no other
+// thread uses SDL_ttf meanwhile); upload() then sends the page to the GPU a
+// few rows at a time on the render thread.  Until the upload is complete
+// the atlas draws nothing.
+// ============================================================================
+class FontAtlas {
+public:
+    FontAtlas();
+    ~FontAtlas();
+    FontAtlas(const FontAtlas &) = delete;
+    FontAtlas &operator=(const FontAtlas &) = delete;
+
+    // Rasterize the font at pointSize into a texture owned by renderer.
+    // TTF must be initialised.  Returns false (and logs) on failure.
+    bool load(SDL_Renderer *renderer, const std::string &path, int pointSize);
+    // First half of load(): glyph metrics and the page in system memory.
+    bool rasterize(const std::string &path, int pointSize);
+    // Second half: upload up to maxRows more rows of the page (creating
+    // the texture on the first call).  Returns false (and logs) on failure.
+    bool upload(SDL_Renderer *renderer, int maxRows);
+    // Rows of the page still to upload.
+    int getPendingRows() const { return page ? textureH - uploadedRows : 0; }
+    void release();
+    // Exchange everything with other (publishing an atlas loaded elsewhere).
+    void swap(FontAtlas &other);
+
+    bool isLoaded() const { return texture != nullptr && !page; }
+    int getLineHeight() const { return lineHeight; }
+    SDL_Texture *getTexture() const { return texture; }
+
+    // Width in pixels of text on one line.
+    int measure(const std::string &text) const;
+
+    // Queue text with its top-left corner at (x, y).
+    void draw(const std::string &text, int x, int y, SDL_Color color);
+    // Queue text centred on (cx, cy).
+    void drawCentered(const std::string &text, int cx, int cy, SDL_Color color);
+    // Queue text centred in rect.
+    void drawInRect(const std::string &text, const SDL_Rect &rect, SDL_Color color);
+
+    // Draw and clear the queued text.
+    void flush();
+
+private:
+    static const int FIRST_CHAR = 32;   // ' '
+    static const int LAST_CHAR = 126;   // '~'
+    static const int CHAR_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+
+    struct Glyph {
+        SDL_Rect src;     // cell in the atlas page (w == 0: nothing to draw)
+        int offsetX;      // cell position relative to the pen
+        int advance;      // pen movement after this glyph
+    };
+
+    // One glyph cell on screen.
+    struct Quad {
+        SDL_Rect src;
+        SDL_Rect dst;
+        SDL_Color color;
+    };
+
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    SDL_Surface *page;        // rasterized, not yet (fully) uploaded
+    int uploadedRows;
+    int textureW, textureH;
+    int lineHeight;
+    Glyph glyphs[CHAR_COUNT];
+    // Kerning between consecutive glyphs, [left][right] (empty without
+    // kerning support in SDL_ttf)
+    std::vector<signed char> kerning;
+
+    std::vector<Quad> queue;
+    std::vector<SDL_Vertex> vertices;   // flush() scratch
+    std::vector<int> indices;
+
+    const Glyph *glyphFor(char c) const;
+    int kern(char left, char right) const;
+};
@@ -1,17 +1,21 @@
 #pragma once
 
 #include <SDL.h>
-#include <SDL_ttf.h>
+#include "FontAtlas.h"
+#include <memory>
 #include <string>
 
+class SDLFramework;
+
 // Simple Heads-Up Display that renders team scores and a countdown timer.
 class HUD {
 public:
     HUD();
     ~HUD();
 
-    // Initialize TTF and load font. Returns false on failure.
-    bool init(const std::string &fontPath, int fontSize = 28);
+    // Fetch the shared font atlases from app (they may still be loading;
+    // text appears once they are ready). Returns false on failure.
+    bool init(SDLFramework &app, const std::string &fontPath, int fontSize = 28);
 
     // Render scores and remaining time onto the screen.
     void render(SDL_Renderer *renderer, int screenW, int screenH,
@@ -22,9 +26,9 @@ public:
                        const std::string &message) const;
 
 private:
-    TTF_Font *font;
-    TTF_Font *bigFont;
+    std::shared_ptr<FontAtlas> font;     // shared with the menus
+    std::shared_ptr<FontAtlas> bigFont;
 
-    void drawText(SDL_Renderer *renderer, const std::string &text,
-                  int x, int y, SDL_Color color, TTF_Font *f = nullptr, bool centered = false) const;
+    void drawText(const std::string &text, int x, int y, SDL_Color color,
+                  FontAtlas *f = nullptr, bool centered = false) const;
 };
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Vector.h"
+#include <cstdint>
+#include <vector>
+
+class Field;
+class PlayerStore;
+
+// ---------------------------------------------------------------------------
+// Team-level influence map.
+//
+// A grid of nodes CELL metres apart over the pitch holding, from one team's
+// point of view, what its AI keeps asking about a spot:
+//
+//   pressure   distance to the nearest opponent
+//   coverage   distance to the nearest teammate
+//   shotValue  angle of the opponents' goal mouth seen from the spot
+//              (a quarter of it if an obstacle blocks the way)
+//   threat     the same for the opponents shooting at our goal
+//   clearance  distance to the nearest obstacle
+//
+// build() refreshes the player terms once per step; the layout terms are
+// only recomputed when the field or the side changes.  Every agent of the
+// team then reads the terms back with bilinear interpolation instead of
+// looping over the players itself.  Distances saturate at MAX_DISTANCE.
+// ---------------------------------------------------------------------------
+class InfluenceMap {
+public:
+    static constexpr float CELL = 1.0f;
+    static constexpr float MAX_DISTANCE = 20.0f;
+
+    // team is the side the map is for (attacking the right goal if
+    // isLeftSide), opponents the other one.
+    void build(const Field &field, bool isLeftSide, const PlayerStore &team,
+               const PlayerStore &opponents);
+
+    bool isBuilt() const { return cols > 0; }
+
+    float pressure(const Vector &p) const  { return sample(PRESSURE, p); }
+    float coverage(const Vector &p) const  { return sample(COVERAGE, p); }
+    float shotValue(const Vector &p) const { return sample(SHOT, p); }
+    float threat(const Vector &p) const    { return sample(THREAT, p); }
+    float clearance(const Vector &p) const { return sample(CLEARANCE, p); }
+
+    // Where a defender coming from `from` should stand with the ball at
+    // ball: in our half, on or near the ball's line to our goal, where the
+    // opponents would have the best shot, and at least `spread` metres from
+    // every point in avoid (teammates and their targets).  Returns from if
+    // no node qualifies.
+    Vector defendSpot(const Vector &ball, const Vector &from,
+                      const std::vector<Vector> &avoid, float spread = 3.0f) const;
+
+private:
+    enum Channel { PRESSURE, COVERAGE, SHOT, THREAT, CLEARANCE, CHANNELS };
+
+    // Layout the static channels belong to
+    uint32_t revision = 0;
+    float width = 0.0f;
+    float height = 0.0f;
+    bool isLeftSide = false;
+
+    int cols = 0;
+    int rows = 0;
+    std::vector<float> data[CHANNELS];   // row-major, cols x rows nodes
+
+    void buildLayout(const Field &field, bool isLeftSide);
+    // Distance from every node to the nearest player of a team.
+    void buildDistances(Channel channel, const PlayerStore &players);
+    float sample(Channel channel, const Vector &p) const;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Vector.h"
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// Batched passing-lane tests.
+//
+// The AI asks "how close does any opponent get to this pass / shot line?"
+// for many lines per tick.  These kernels answer it for a whole batch of
+// segments against all opponents in one call, eight segments at a time with
+// AVX2 or four with SSE2, falling back to plain C++ elsewhere.  The best
+// level the CPU supports is picked on first use.
+//
+// Every path performs the same IEEE operations in the same order as
+// AIAgent::minOpponentDistanceToSegment, so the results are bit-identical
+// whichever one runs and replays stay portable between machines.
+// ============================================================================
+
+enum class LaneSimd {
+    SCALAR,
+    SSE2,   // 4 segments per instruction
+    AVX2    // 8 segments per instruction
+};
+
+// Segments as parallel coordinate arrays.
+struct LaneBatch {
+    std::vector<float> ax, ay;   // start points
+    std::vector<float> bx, by;   // end points
+
+    int size() const { return (int)ax.size(); }
+
+    void clear() {
+        ax.clear();
+        ay.clear();
+        bx.clear();
+        by.clear();
+    }
+
+    void add(const Vector &a, const Vector &b) {
+        ax.push_back(a.x);
+        ay.push_back(a.y);
+        bx.push_back(b.x);
+        by.push_back(b.y);
+    }
+};
+
+// For each segment, the smallest distance from any of the n points
+// (px[j], py[j]) to it; 1e15 when n is 0.  minDist needs lanes.size() floats.
+void laneDistances(const LaneBatch &lanes, const float *px, const float *py, int n,
+                   float *minDist);
+
+// Bit i (of word i / 64) is set when segment i stays farther than
+// clearance from every point, i.e. misses every circle of that radius
+// around them.  mask needs (lanes.size() + 63) / 64 words.
+void laneClearMask(const LaneBatch &lanes, const float *px, const float *py, int n,
+                   float clearance, uint64_t *mask);
+
+inline bool laneBit(const uint64_t *mask, int i) {
+    return (mask[i >> 6] >> (i & 63)) & 1u;
+}
+
+// Best level this CPU supports, and the level currently in use.
+LaneSimd laneSimdSupported();
+LaneSimd laneSimdLevel();
+
+// Force a level (clamped to what the CPU supports), e.g. to benchmark the
+// paths against each other.
+void setLaneSimdLevel(LaneSimd level);
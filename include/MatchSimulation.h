@@ -0,0 +1,199 @@
+#pragma once
+
+#include "Vector.h"
+#include "Field.h"
+#include "Obstacle.h"
+#include "Ball.h"
+#include "Team.h"
+#include "AIAgent.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ReplayRecorder;
+class ReplayPlayer;
+class ThreadPool;
+
+// ============================================================================
+// Headless match simulation.
+//
+// Owns the complete game state of one match (field, ball, both teams, AI
+// agents, timer) and advances it with step().  Nothing in here touches the
+// window, fonts or images, so it can run on machines without a display
+// (AI tuning, regression runs); the sigma_strikers executable is only a
+// frontend that feeds keyboard input in and draws the state it reads back.
+// ============================================================================
+
+// Who controls which team.
+enum GameMode {
+    MODE_VS_AI,    // Player vs AI (single player controls Team 1)
+    MODE_PVP,      // Player vs Player (local 2-player)
+    MODE_AI_VS_AI  // Both teams AI-controlled (headless runs)
+};
+
+// What happened during a step.  Ordered by importance so advance() can
+// report the most significant event of several steps.
+enum class MatchEvent {
+    NONE,
+    TEAM1_GOAL,   // ball entered the right goal
+    TEAM2_GOAL,   // ball entered the left goal
+    MATCH_OVER    // timer ran out during this step
+};
+
+// Inputs for both teams for one step.  Ignored for AI-controlled teams.
+struct MatchInputs {
+    TeamInput team1;
+    TeamInput team2;
+};
+
+class MatchSimulation {
+public:
+    // Physics runs at a fixed 120 Hz regardless of the display refresh rate.
+    static constexpr float FIXED_DT = 1.0f / 120.0f;
+
+    // playersPerTeam is the squad size of each side (2 for the classic
+    // 2v2, up to 11).  A non-zero seed shifts every kick-off position by a
+    // small pseudo-random amount, so otherwise identical AI matches play
+    // out differently; seed 0 uses the exact formation.
+    MatchSimulation(const Field &field, GameMode mode = MODE_VS_AI,
+                    float matchDuration = 120.0f, int playersPerTeam = 2,
+                    uint32_t seed = 0);
+
+    // The 40x20 m pitch with the standard obstacle layout.
+    static Field createDefaultField();
+
+    // Advance the match by dt seconds.  Does nothing once the match is over.
+    // Headless callers normally pass FIXED_DT.
+    MatchEvent step(float dt, const MatchInputs &inputs);
+
+    // Advance by a wall-clock frame time: accumulates frameDt and runs as
+    // many FIXED_DT steps as fit, carrying the remainder to the next frame.
+    // Swap presses are latched until a step consumes them.  Returns the most
+    // important event of the steps taken.
+    MatchEvent advance(float frameDt, const MatchInputs &inputs);
+
+    // Same, but each step takes its inputs from a replay instead of the
+    // live keyboard.  speed scales simulated time per wall-clock second
+    // (2 = double speed).  Stops stepping once the replay runs out.
+    MatchEvent advance(float frameDt, ReplayPlayer &replay, float speed = 1.0f);
+
+    // Record the inputs of every step into recorder (nullptr to stop).
+    // Call recorder->begin(*this) first so it captures the match setup.
+    void setRecorder(ReplayRecorder *recorder) { this->recorder = recorder; }
+
+    // Run team 2's AI on pool while the calling thread runs team 1's
+    // (nullptr = both on the calling thread).  The result is bit-identical
+    // either way.  pool must not be one this simulation is itself stepped
+    // from, since a step waits for it.
+    void setThreadPool(ThreadPool *pool) { this->pool = pool; }
+    ThreadPool *getThreadPool() const { return pool; }
+
+    // How far (0..1) the accumulator is between the last two steps.
+    float getInterpolationAlpha() const { return accumulator / FIXED_DT; }
+
+    // Ball and teams with positions interpolated between the previous and
+    // current step by getInterpolationAlpha(), for smooth rendering.
+    Ball getRenderBall() const;
+    Team getRenderTeam1() const;
+    Team getRenderTeam2() const;
+
+    // State at the start of the last step (what getRender*() interpolate from).
+    const Ball &getPrevBall()  const { return prevBall; }
+    const Team &getPrevTeam1() const { return prevTeam1; }
+    const Team &getPrevTeam2() const { return prevTeam2; }
+
+    // Reset scores, positions and timer for a new match.
+    void restart(float matchDuration);
+
+    // Replace the AI driving team 1 or 2 (e.g. with different tuning).
+    // Call before the first step; replays do not record the AI settings.
+    // The new AI uses the match's flow fields like the one it replaces.
+    void setTeamAI(int team, const AIAgent &ai);
+    const AIAgent &getTeamAI(int team) const { return team == 1 ? ai1 : ai2; }
+
+    const Field &getField() const { return field; }
+    const Ball  &getBall()  const { return ball; }
+    const Team  &getTeam1() const { return team1; }
+    const Team  &getTeam2() const { return team2; }
+    GameMode getMode() const { return mode; }
+    uint32_t getSeed() const { return seed; }
+    int getPlayersPerTeam() const { return team1.size(); }
+
+    float getTimeRemaining() const { return matchTime; }
+    bool  isOver() const { return gameOver; }
+
+    // 0 = draw, 1 = team 1 ahead, 2 = team 2 ahead
+    int getLeader() const;
+
+    // FNV-1a hash over the bit patterns of the dynamic state (ball, players,
+    // scores, timer).  Two runs that agree on this are bit-identical, which
+    // is what replay regression checks compare.
+    uint64_t stateHash() const;
+
+private:
+    Field field;
+    Ball ball;
+    Team team1;   // blue, left side
+    Team team2;   // red, right side
+    SpatialGrid playerGrid;  // broadphase over the players of both teams
+
+    // ai1 controls Team 1's inactive players (or all of Team 1 in AI vs AI)
+    // ai2 controls Team 2 entirely in VS_AI mode, or just inactive players in PvP
+    AIAgent ai1;
+    AIAgent ai2;
+    // Flow fields round the obstacles, shared by both AIs (and by copies
+    // of this simulation, which is safe: the Navigator locks itself)
+    std::shared_ptr<Navigator> navigator;
+
+    GameMode mode;
+    uint32_t seed;
+    uint32_t rngState;      // xorshift state for the kick-off jitter
+    float matchTime;
+    bool gameOver;
+
+    // Fixed-step bookkeeping
+    float accumulator;      // unsimulated wall-clock time (seconds)
+    bool  pendingSwap1;     // swap presses waiting for the next step
+    bool  pendingSwap2;
+    // State at the start of the last step: the interpolation start point,
+    // and during a step the snapshot both AIs read instead of the live state
+    Ball  prevBall;
+    Team  prevTeam1;
+    Team  prevTeam2;
+
+    ReplayRecorder *recorder;  // not owned
+    ThreadPool *pool;          // not owned
+
+    Team interpolateTeam(const Team &prev, const Team &cur) const;
+
+    // Shared accumulator loop behind both advance() overloads.  Takes
+    // per-step inputs from replay if given, otherwise uses live.
+    MatchEvent runFixedSteps(float simDt, const MatchInputs &live,
+                             ReplayPlayer *replay);
+
+    // Move both teams (AI and human input) and apply the AIs' kicks.
+    void updateTeams(float dt, const MatchInputs &inputs);
+
+    // One side's share of updateTeams (1 or 2): writes only that team and
+    // its AIAgent, reads the ball and the other team from the snapshot.
+    void updateSide(int side, float dt, const MatchInputs &inputs);
+
+    // Apply the pass/shot an AI decided on this step to the ball.
+    void applyAIKicks(const AIAgent &ai, Team &team);
+
+    // Player/obstacle overlaps, then the ball's swept move for this step.
+    // Returns the goal code from Field::handleCollision / Field::moveBall
+    // (0 = none, 1 = left goal, 2 = right goal).
+    int resolveCollisions(float dt);
+
+    // Kick-off positions of an n-player team on the left (or right) half.
+    static std::vector<Vector> kickoffFormation(const Field &field, int n,
+                                                bool isLeftSide);
+
+    // Next value of the kick-off jitter generator, in [-1, 1].
+    float nextJitter();
+
+    // Put players and ball back to their kick-off positions.  Also snaps
+    // the interpolation history so the reset is not drawn as a slide.
+    void resetPositions();
+};
@@ -21,16 +21,25 @@ MainMenuChoice showMainMenu(SDLFramework &app);
 // Show a basic tutorial screen with instructions.
 void showTutorial(SDLFramework &app);
 
-// Settings menu with resolution and game duration options.
-// Returns the selected match duration in seconds (60, 120, 180, or 300).
+// Settings menu with resolution, game duration, team size and AI options.
 struct GameSettings {
-    int matchDuration; // seconds
+    int matchDuration;  // seconds (60, 120, 180, or 300)
+    int playersPerTeam; // 2, 3, 5, or 11
+    int aiLevel;        // 0 = normal, 1 = hard, 2 = expert
 };
 
+// Seconds of thinking time the AI opponents' rollout planner gets per
+// decision on the ball at an aiLevel (0 = the fixed priorities, no planner).
+float aiPlanBudget(int aiLevel);
+
 // Global settings
 extern GameSettings gSettings;
 
-// Show settings menu (resolution + match duration)
+// Show settings menu (resolution + match duration + team size + AI level)
 void showSettingsMenu(SDLFramework &app);
 
+// Show a progress bar until background loading has finished.  Returns
+// false if the window was closed meanwhile.
+bool showLoadingScreen(SDLFramework &app);
+
 #endif // MENU_H
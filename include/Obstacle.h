@@ -2,40 +2,53 @@
 
 #include "Vector.h"
 #include <SDL.h>
+#include <vector>
 
 class Field;
-class Ball;
-class Player;
-
-// Simple axis-aligned rectangular obstacle placed on the field.  The
-// position is specified in world coordinates (metres) referring to the
-// obstacle's centre.  The obstacle does not move at runtime; it merely
-// collides with the ball and players, pushing them away or bouncing the
-// ball back.
+class ShapeBatch;
+class Camera;
+
+// Outline of an obstacle.
+enum class ObstacleShape {
+    RECT,     // axis-aligned rectangle
+    CIRCLE,
+    POLYGON   // any simple polygon, either winding
+};
+
+// Static obstacle placed on the field.  The position is specified in world
+// coordinates (metres) and refers to the obstacle's centre (the centre of
+// its bounding box for polygons).  Obstacles do not move at runtime; the
+// Field bakes them into a signed distance field when they are added and
+// answers every collision and visibility query from that, so an obstacle
+// itself only needs to describe its shape.
 class Obstacle {
 public:
-    Obstacle(const Vector &centre = Vector(), float w = 1.0f, float h = 1.0f)
-        : pos(centre), width(w), height(h) {}
+    // Rectangle of w x h metres centred on centre.
+    Obstacle(const Vector &centre = Vector(), float w = 1.0f, float h = 1.0f);
+
+    static Obstacle circle(const Vector &centre, float radius);
 
-    // Render the obstacle inside the provided field viewport.
-    void render(SDL_Renderer *renderer, const Field &field,
-                int screenW, int screenH) const;
+    // Polygon through points (world coordinates, at least 3).
+    static Obstacle polygon(const std::vector<Vector> &points);
 
-    // Check and resolve a collision between this obstacle and the ball.
-    // If an intersection is detected the ball is moved out of the obstacle
-    // and its velocity is reflected.  Returns true if a collision occurred.
-    bool handleBallCollision(Ball &ball) const;
+    // Render the obstacle where the camera shows it.
+    void render(ShapeBatch &batch, const Camera &camera) const;
 
-    // Push a player out of the obstacle if they overlap.  This is used by
-    // Field::handlePlayerCollision.
-    void resolvePlayerCollision(Player &player) const;
+    // Exact signed distance from p to the outline: negative inside,
+    // positive outside.
+    float signedDistance(const Vector &p) const;
 
+    ObstacleShape getShape() const { return shape; }
     Vector getPos() const { return pos; }
-    float getWidth() const { return width; }
+    float getWidth() const { return width; }     // bounding box size
     float getHeight() const { return height; }
+    float getRadius() const { return width / 2.0f; }   // CIRCLE only
+    const std::vector<Vector> &getPoints() const { return points; }  // POLYGON only
 
 private:
+    ObstacleShape shape;
     Vector pos;   // centre in metres
     float width;  // metres
     float height; // metres
+    std::vector<Vector> points;
 };
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Vector.h"
+#include <cmath>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Structure-of-arrays storage for the players of one team.
+//
+// Every attribute lives in its own contiguous array indexed by player
+// number.  Systems that touch one attribute of every player (collision,
+// the AI's opponent scans, render interpolation) become tight loops over
+// plain float arrays that the compiler can vectorise, and a team can hold
+// any number of players (2v2, 5v5, 11v11) without per-player code.
+// ---------------------------------------------------------------------------
+class PlayerStore {
+public:
+    std::vector<float> x;       // position (metres)
+    std::vector<float> y;
+    std::vector<float> vx;      // velocity measured over the last step (m/s)
+    std::vector<float> vy;
+    std::vector<float> radius;  // collision radius (metres)
+    std::vector<float> speed;   // top speed (metres per second)
+
+    int size() const { return (int)x.size(); }
+
+    // Append a player and return its index.
+    int add(const Vector &pos, float spd = 20.0f, float rad = 0.8f) {
+        x.push_back(pos.x);
+        y.push_back(pos.y);
+        vx.push_back(0.0f);
+        vy.push_back(0.0f);
+        radius.push_back(rad);
+        speed.push_back(spd);
+        return size() - 1;
+    }
+
+    Vector getPos(int i) const { return Vector(x[i], y[i]); }
+    void   setPos(int i, const Vector &p) { x[i] = p.x; y[i] = p.y; }
+    Vector getVel(int i) const { return Vector(vx[i], vy[i]); }
+
+    void translate(int i, const Vector &d) { x[i] += d.x; y[i] += d.y; }
+
+    // Index of the player closest to p (lowest index wins ties), or -1 if
+    // the store is empty.
+    int nearestTo(const Vector &p) const {
+        int best = -1;
+        float bestD2 = 0.0f;
+        for (int i = 0; i < size(); ++i) {
+            float dx = x[i] - p.x;
+            float dy = y[i] - p.y;
+            float d2 = dx * dx + dy * dy;
+            if (best < 0 || d2 < bestD2) {
+                best = i;
+                bestD2 = d2;
+            }
+        }
+        return best;
+    }
+
+    // Distance from p to the closest player (a large value if empty).
+    float nearestDistance(const Vector &p) const {
+        float bestD2 = 1e30f;
+        const int n = size();
+        for (int i = 0; i < n; ++i) {
+            float dx = x[i] - p.x;
+            float dy = y[i] - p.y;
+            float d2 = dx * dx + dy * dy;
+            bestD2 = d2 < bestD2 ? d2 : bestD2;
+        }
+        return std::sqrt(bestD2);
+    }
+
+    // Set the velocity buffers from the displacement since prev (same
+    // players, start of the step) over dt seconds.
+    void measureVelocities(const PlayerStore &prev, float dt) {
+        const int n = size();
+        const float inv = 1.0f / dt;
+        for (int i = 0; i < n; ++i) {
+            vx[i] = (x[i] - prev.x[i]) * inv;
+            vy[i] = (y[i] - prev.y[i]) * inv;
+        }
+    }
+
+    // Positions interpolated between a (t = 0) and b (t = 1), which must
+    // hold the same players.  Other attributes are taken from b.
+    void interpolate(const PlayerStore &a, const PlayerStore &b, float t) {
+        *this = b;
+        const int n = size();
+        for (int i = 0; i < n; ++i) {
+            x[i] = a.x[i] + (b.x[i] - a.x[i]) * t;
+            y[i] = a.y[i] + (b.y[i] - a.y[i]) * t;
+        }
+    }
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// What a timed scope belongs to.  Zones may nest (a zone's time includes
+// anything timed inside it).
+enum class ProfileZone {
+    INPUT,          // event polling
+    AI,             // AIAgent team updates
+    COLLISION,      // player, obstacle, wall and ball collision passes
+    FIELD_RENDER,   // field layer (redraws show up as spikes)
+    TEAM_RENDER,    // players and ball
+    SUBMIT,         // ShapeBatch flush
+    HUD_RENDER,     // HUD and messages
+    PRESENT,        // SDL_RenderPresent (includes waiting for vsync)
+    COUNT
+};
+
+// ============================================================================
+// Frame profiler.
+//
+// PROFILE_SCOPE(zone) times the rest of the enclosing block and adds it to
+// the zone's total for the current frame; PROFILE_FRAME() closes the frame
+// into a ring buffer of the last HISTORY frames.  Scopes on the thread that
+// closes frames make up the frame time; scopes on any other thread (the
+// simulation thread) are kept apart as background time, which runs
+// alongside the frame rather than inside it.  Every scope is also kept
+// as a trace event (the last MAX_EVENTS of them) for a Chrome trace
+// (chrome://tracing, Perfetto) showing exactly where a spike went.
+//
+// The macros compile to nothing unless SIGMA_PROFILE is defined (CMake
+// option SIGMA_PROFILE), and cost one relaxed load while recording is
+// switched off with setEnabled(false), the default; a recorded scope takes
+// a mutex, so the game only records while someone is looking.  Scopes may
+// run on any thread; endFrame(), the readers and the writers belong to one
+// thread.
+// ============================================================================
+class Profiler {
+public:
+    static const int HISTORY = 240;
+    static const int MAX_EVENTS = 16384;
+
+#ifdef SIGMA_PROFILE
+    static constexpr bool COMPILED_IN = true;
+#else
+    static constexpr bool COMPILED_IN = false;
+#endif
+
+    static Profiler &instance();
+
+    void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Nanoseconds on a steady clock.
+    static uint64_t now();
+
+    // Add a finished scope (normally done by ProfileScope).
+    void record(ProfileZone zone, uint64_t start, uint64_t end);
+    // Close the current frame.
+    void endFrame();
+    // Forget the frame history and the kept scopes.
+    void clear();
+
+    // Frames in the history (at most HISTORY).
+    int getFrameCount() const { return frameCount; }
+    // Milliseconds of a finished frame, 0 = the last one.
+    float getFrameMs(int framesAgo) const;
+    float getZoneMs(int framesAgo, ProfileZone zone) const;
+    // Milliseconds the zone took on other threads during that frame.
+    float getBackgroundMs(int framesAgo, ProfileZone zone) const;
+
+    static const char *zoneName(ProfileZone zone);
+
+    // One row per frame in the history: frame time, every zone and every
+    // zone's background time, in ms.
+    bool writeCsv(const std::string &path) const;
+    // The kept scopes as a Chrome trace event file.
+    bool writeChromeTrace(const std::string &path) const;
+
+private:
+    static const int ZONES = (int)ProfileZone::COUNT;
+
+    struct Frame {
+        uint64_t start, end;
+        uint64_t zones[ZONES];        // ns, on the frame thread
+        uint64_t background[ZONES];   // ns, on other threads
+    };
+    struct Event {
+        uint64_t start, end;
+        ProfileZone zone;
+        int thread;
+    };
+
+    Profiler();
+
+    std::atomic<bool> enabled;
+    const uint64_t epoch;
+
+    // Current frame, added to from any thread
+    std::atomic<uint64_t> current[ZONES];
+    std::atomic<uint64_t> currentBackground[ZONES];
+    std::atomic<int> frameThread;   // thread index closing frames, -1 = none yet
+    uint64_t frameStart;
+
+    std::vector<Frame> frames;   // ring of HISTORY
+    int frameHead;               // next slot
+    int frameCount;
+
+    mutable std::mutex eventMutex;
+    std::vector<Event> events;   // ring of MAX_EVENTS
+    size_t eventHead;
+    size_t eventCount;
+
+    const Frame &frameAt(int framesAgo) const;
+};
+
+// Times its own lifetime into a zone.
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone z)
+    : zone(z), start(Profiler::instance().isEnabled() ? Profiler::now() : 0) {}
+    ~ProfileScope() {
+        if (start) Profiler::instance().record(zone, start, Profiler::now());
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    ProfileZone zone;
+    uint64_t start;
+};
+
+#ifdef SIGMA_PROFILE
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_JOIN(profileScope_, __LINE__)(zone)
+#define PROFILE_FRAME() Profiler::instance().endFrame()
+#else
+#define PROFILE_SCOPE(zone) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SDL.h>
+#include "FontAtlas.h"
+#include <memory>
+
+class SDLFramework;
+class ShapeBatch;
+
+// In-game graph of the profiler's frame history: one stacked bar per frame
+// (oldest on the left) split into the per-subsystem zones, over the whole
+// frame time in grey, with 16.7 ms and 33.3 ms guides.  Below it a second
+// row stacks the zones timed on other threads (the simulation thread) during
+// each frame, and a legend gives each zone's average and worst time over
+// the last second.
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+
+    // Fetch the legend font from app. Returns false on failure.
+    bool init(SDLFramework &app);
+
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    // Draw the overlay in the top-right corner (flushes batch and the font).
+    void render(ShapeBatch &batch, int screenW, int screenH) const;
+
+private:
+    std::shared_ptr<FontAtlas> font;
+    bool visible;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "MatchSimulation.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Replay recording and playback.
+//
+// A replay holds everything needed to re-run a match bit-exactly through
+// MatchSimulation: the match setup (mode, team size, duration, pitch size,
+// obstacle layout) and the TeamInput of every fixed step.  Each team's input
+// packs into one byte and consecutive identical steps are run-length
+// encoded, so a two-minute match is typically a few kilobytes.
+//
+// File layout (little-endian):
+//   "SSRP"  u16 version  u16 tickRate  u8 mode  u8 playersPerTeam  u32 seed
+//   f32 matchDuration  f32 fieldWidth  f32 fieldHeight  u16 obstacleCount
+//   obstacleCount x { u8 shape, then
+//                     RECT:    f32 x  f32 y  f32 w  f32 h
+//                     CIRCLE:  f32 x  f32 y  f32 radius
+//                     POLYGON: u16 n  n x { f32 x  f32 y } }
+//   u32 runCount
+//   runCount x { u8 team1  u8 team2  varint steps }
+// ============================================================================
+
+// Match setup stored at the start of a replay.
+struct ReplayHeader {
+    GameMode mode;
+    int playersPerTeam;
+    uint32_t seed;           // kick-off jitter seed (0 = exact formation)
+    float matchDuration;     // seconds
+    float fieldWidth;        // metres
+    float fieldHeight;       // metres
+    std::vector<Obstacle> obstacles;
+};
+
+// A run of consecutive steps that all received the same inputs.
+struct ReplayRun {
+    uint8_t team1;    // packed TeamInput bits
+    uint8_t team2;
+    uint32_t steps;
+};
+
+// Pack / unpack a TeamInput into the 5-bit form used in replay files.
+uint8_t packTeamInput(const TeamInput &in);
+TeamInput unpackTeamInput(uint8_t bits);
+
+class ReplayRecorder {
+public:
+    ReplayRecorder();
+
+    // Start a new recording from the current (freshly created or restarted)
+    // state of the simulation.  Discards anything recorded before.
+    void begin(const MatchSimulation &sim);
+
+    // Called by MatchSimulation::step() with the inputs of every step.
+    void recordStep(const MatchInputs &inputs);
+
+    // Write the recording to disk.  Returns false on I/O failure.
+    bool save(const std::string &path) const;
+
+    int getStepCount() const { return stepCount; }
+
+private:
+    ReplayHeader header;
+    std::vector<ReplayRun> runs;
+    int stepCount;
+};
+
+class ReplayPlayer {
+public:
+    ReplayPlayer();
+
+    // Read a replay file.  Returns false (and logs why) if it cannot be
+    // read or was recorded with a different tick rate.
+    bool load(const std::string &path);
+
+    const ReplayHeader &getHeader() const { return header; }
+
+    // Build a simulation in the exact starting state of the recording.
+    MatchSimulation createSimulation() const;
+
+    // Inputs for the next step.  Returns false once every recorded step
+    // has been played.
+    bool nextInputs(MatchInputs &out);
+
+    bool isFinished() const { return runIndex >= runs.size(); }
+    int  getStepCount() const { return stepCount; }
+    int  getStepIndex() const { return stepIndex; }
+
+    // Rewind to the first step.
+    void rewind();
+
+    // Play every remaining step through sim as fast as possible (no
+    // rendering, no wall-clock pacing).
+    void runToEnd(MatchSimulation &sim);
+
+private:
+    ReplayHeader header;
+    std::vector<ReplayRun> runs;
+    int stepCount;
+
+    // playback cursor
+    size_t   runIndex;
+    uint32_t stepInRun;
+    int      stepIndex;
+};
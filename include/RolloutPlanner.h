@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Vector.h"
+#include "BallPredictor.h"
+#include <cstdint>
+#include <vector>
+
+class Ball;
+class Field;
+class InfluenceMap;
+class PlayerStore;
+
+// ---------------------------------------------------------------------------
+// Monte Carlo planner for the player on the ball.
+//
+// Given the actions open to the player (keep dribbling, shoot at a target,
+// pass to a teammate), choose() plays many short randomised rollouts of
+// each from a light copy of the situation and picks the one with the best
+// average outcome.  A rollout of a kick perturbs its direction and speed,
+// traces the ball with a BallPredictor and races every player to it, each
+// with a random reaction delay and speed; a dribble runs the carrier
+// upfield while the opponents close in.  The outcome is scored from our
+// side, in [-1, 1]:
+//
+//   +1 / -1   the ball goes into their / our goal untouched
+//   +-(0.3..0.7)  we / they reach it first, more the better placed it is
+//              for a shot (the influence map's shot and threat values)
+//    0        nobody reaches it in time
+//
+// Rollouts go to the actions by UCB1, so the promising ones get more of
+// them, and stop when the wall-clock budget runs out (or at the rollout
+// cap): the answer is always the best so far, so the quality of play
+// scales with the budget.  Rollouts are random but seeded, so a fixed
+// number of them gives the same answer every time; a time budget does
+// not, because how many fit depends on the machine.
+// ---------------------------------------------------------------------------
+struct PlanAction {
+    enum Kind { DRIBBLE, SHOOT, PASS };
+    Kind   kind;
+    Vector target;        // shot target, pass receiver's position, or dribble goal
+    int    receiver = -1; // PASS only
+};
+
+class RolloutPlanner {
+public:
+    // Seconds a rollout looks ahead.
+    static constexpr float HORIZON = 2.5f;
+
+    void clearActions() { actions.clear(); }
+    void addAction(const PlanAction &action) { actions.push_back(action); }
+    const std::vector<PlanAction> &getActions() const { return actions; }
+
+    // Index of the best action for player `active` of team (attacking the
+    // right goal if isLeftSide), running rollouts for up to budget seconds
+    // but at most maxRollouts of them.  reaction scales every player's
+    // top speed, as AIAgent's does.  -1 if there are no actions.
+    int choose(const Ball &ball, const Field &field, const InfluenceMap &influence,
+               const PlayerStore &team, int active, const PlayerStore &opponents,
+               bool isLeftSide, float reaction, float budget, int maxRollouts);
+
+    // Results of the last choose().
+    int getRollouts() const { return rollouts; }
+    float getValue(int action) const {
+        return counts[action] ? sums[action] / counts[action] : 0.0f;
+    }
+
+private:
+    // Everything a rollout reads
+    struct Situation {
+        const Ball *ball;
+        const Field *field;
+        const InfluenceMap *influence;
+        const PlayerStore *team;
+        const PlayerStore *opponents;
+        int active;
+        bool isLeftSide;
+        float reaction;
+    };
+
+    std::vector<PlanAction> actions;
+    std::vector<float> sums;
+    std::vector<int> counts;
+    int rollouts = 0;
+    uint32_t rngState = 0x9E3779B9u;
+    BallPredictor predictor;
+
+    float random(float lo, float hi);
+
+    float rollout(const Situation &s, const PlanAction &action);
+    float rolloutKick(const Situation &s, const PlanAction &action);
+    float rolloutDribble(const Situation &s, const PlanAction &action);
+    // Value of team `ours` (or theirs) winning the ball at p.
+    float possessionValue(const Situation &s, const Vector &p, bool ours) const;
+};
@@ -2,6 +2,9 @@
 #define SDLFRAMEWORK_H
 
 #include <SDL.h>
+#include "AssetManager.h"
+#include "FieldLayer.h"
+#include <memory>
 #include <string>
 
 
@@ -11,8 +14,14 @@ public:
     ~SDLFramework();
     bool init(const std::string &title, int w, int h);
     void run();
-    // Change resolution at runtime. Returns true on success.
+    // Change resolution at runtime by resizing the window and the logical
+    // drawing size; the renderer, textures and font atlases are kept.
+    // Returns true on success.
     bool setResolution(int w, int h);
+    // Switch between a window and desktop fullscreen.  In fullscreen the
+    // w x h drawing area is scaled (letterboxed) to the screen.
+    bool setFullscreen(bool on);
+    bool isFullscreen() const { return fullscreen; }
 
     // Accessors for renderer/window for simple UI drawing
     SDL_Renderer* getRenderer();
@@ -20,16 +29,27 @@ public:
     int getWidth() const;
     int getHeight() const;
 
-    SDL_Texture* getFieldTexture() const { return fieldTexture; }
-    SDL_Texture* getBallTexture() const { return ballTexture; }
-    SDL_Texture* getPlayerTexture() const { return playerTexture; }
+    // Field, ball and shape sprites packed in one texture; empty until the
+    // loader has built it.
+    const SpriteAtlas& getSprites() const { return assets.getSprites(); }
+
+    // Shared glyph atlas for a font file at a point size, loaded in the
+    // background on first use; it draws nothing until it is ready (or if
+    // the font can't be loaded).  Returns nullptr only before init().
+    std::shared_ptr<FontAtlas> getFont(const std::string &path, int pointSize);
+
+    // Background loader; call getAssets().update() once per frame.
+    AssetManager& getAssets() { return assets; }
+
+    // Cached drawing of the static field; released with the renderer.
+    FieldLayer& getFieldLayer() { return fieldLayer; }
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
-    SDL_Texture* fieldTexture;
-    SDL_Texture* ballTexture;
-    SDL_Texture* playerTexture;    // new player sprite slot
+    AssetManager assets;
+    FieldLayer fieldLayer;
     bool running;
+    bool fullscreen;
     int width;
     int height;
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// ============================================================================
+// Batched 2D drawing.
+//
+// Filled circles, rings, rectangles, lines, polygons and textured sprites
+// are turned into triangles and appended to one vertex buffer.  Nothing
+// reaches the renderer until the texture changes or flush() is called, so
+// a frame of field lines, obstacles and any number of players costs a
+// handful of SDL_RenderGeometry calls instead of one call per scanline or
+// outline point.
+//
+// Coordinates are screen pixels.  Shapes drawn later cover earlier ones,
+// as with immediate drawing; flush() before drawing anything that does not
+// go through the batch.
+// ============================================================================
+class ShapeBatch {
+public:
+    explicit ShapeBatch(SDL_Renderer *renderer = nullptr);
+
+    // Flushes anything queued for the previous renderer.
+    void setRenderer(SDL_Renderer *renderer);
+    SDL_Renderer *getRenderer() const { return renderer; }
+
+    void fillRect(const SDL_FRect &rect, SDL_Color color);
+    // Outline drawn inside rect.
+    void drawRect(const SDL_FRect &rect, float thickness, SDL_Color color);
+    // Line between pixel centres, like SDL_RenderDrawLine at thickness 1.
+    void line(float x0, float y0, float x1, float y1, float thickness, SDL_Color color);
+    void fillTriangle(SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, SDL_Color color);
+
+    void fillCircle(float cx, float cy, float radius, SDL_Color color);
+    // Band between radius - thickness and radius.
+    void ring(float cx, float cy, float radius, float thickness, SDL_Color color);
+
+    // Convex outline, filled as a fan.
+    void fillConvex(const SDL_FPoint *points, int count, SDL_Color color);
+    // Any simple polygon, either winding (ear clipping).
+    void fillPolygon(const SDL_FPoint *points, int count, SDL_Color color);
+    void drawPolygon(const SDL_FPoint *points, int count, float thickness, SDL_Color color);
+
+    // Whole texture stretched over dst and multiplied by tint (replaces
+    // SDL_SetTextureColorMod / AlphaMod).
+    void sprite(SDL_Texture *texture, const SDL_FRect &dst, SDL_Color tint);
+    // Part of a texture, given in normalised texture coordinates (an atlas
+    // cell), stretched over dst.
+    void sprite(SDL_Texture *texture, const SDL_FRect &dst, const SDL_FRect &uv,
+                SDL_Color tint);
+
+    // Submit everything queued.
+    void flush();
+
+    // SDL_RenderGeometry calls made since the last resetStats().
+    int getDrawCalls() const { return drawCalls; }
+    void resetStats() { drawCalls = 0; }
+
+private:
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;   // texture of the queued triangles (null: untextured)
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::vector<int> earScratch;
+    int drawCalls;
+
+    // Flush if the queued triangles use another texture.
+    void useTexture(SDL_Texture *tex);
+    int addVertex(float x, float y, SDL_Color color, float u = 0.0f, float v = 0.0f);
+    void addQuad(int a, int b, int c, int d);
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "MatchSimulation.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+class ReplayPlayer;
+
+// Everything the renderer needs from one moment of a match, copied out of
+// the simulation so it can be drawn while the next steps run.
+struct MatchSnapshot {
+    Ball prevBall;     // the last two steps, for interpolation
+    Ball ball;
+    Team prevTeam1;
+    Team team1;
+    Team prevTeam2;
+    Team team2;
+    float alpha = 0.0f;            // interpolation alpha when taken
+    std::chrono::steady_clock::time_point takenAt;
+    float timeRemaining = 0.0f;
+    bool over = false;
+    int leader = 0;                // as MatchSimulation::getLeader()
+
+    // Latest goal / end of match, and how many events there have been so
+    // far, so a reader that skipped snapshots still sees that one happened.
+    MatchEvent lastEvent = MatchEvent::NONE;
+    uint32_t eventCount = 0;
+
+    // Where between the two steps the simulation is now: alpha advanced
+    // by the time since the snapshot was taken, at most 1.
+    float renderAlpha() const;
+    Ball renderBall(float alpha) const;
+    Team renderTeam1(float alpha) const;
+    Team renderTeam2(float alpha) const;
+};
+
+// ============================================================================
+// Match simulation on its own thread.
+//
+// The thread advances the MatchSimulation against the wall clock, sleeping
+// until the next fixed step is due, and publishes a MatchSnapshot after
+// every advance through a triple buffer.  The render thread always picks
+// up the newest complete snapshot without waiting for the simulation, so
+// a slow frame or a long vsync wait never changes when steps happen.
+//
+// Input goes the other way through atomics: the held movement keys as bit
+// sets and the edge-triggered swap presses as counters, so a press is not
+// lost whatever the two threads' rates are.
+//
+// While the thread runs it is the only user of the simulation (and of the
+// replay and recorder attached to it); stop() hands it back.
+// ============================================================================
+class SimThread {
+public:
+    // With a replay the inputs come from it, at replaySpeed, instead of
+    // from setInputs().
+    SimThread(MatchSimulation &sim, ReplayPlayer *replay = nullptr, float replaySpeed = 1.0f);
+    ~SimThread();
+    SimThread(const SimThread &) = delete;
+    SimThread &operator=(const SimThread &) = delete;
+
+    // Publish the simulation's current state and start stepping it.
+    void start();
+    // Stop and join the thread; the simulation can then be used directly.
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+
+    // Movement keys held now (the swap flags are ignored).
+    void setInputs(const MatchInputs &inputs);
+    // A swap key of team 1 or 2 was pressed.
+    void pressSwap(int team);
+
+    // Newest published snapshot; valid until the next call.  Call from
+    // one thread only.
+    const MatchSnapshot &latest();
+
+private:
+    MatchSimulation &sim;
+    ReplayPlayer *replay;
+    float replaySpeed;
+    std::thread thread;
+    std::atomic<bool> stopping;
+
+    // Written by the caller, read by the thread
+    std::atomic<uint8_t> moves1;       // packTeamInput() bits
+    std::atomic<uint8_t> moves2;
+    std::atomic<uint32_t> swaps1;      // presses so far
+    std::atomic<uint32_t> swaps2;
+
+    // Simulation thread only
+    uint32_t usedSwaps1;               // presses passed on to the simulation
+    uint32_t usedSwaps2;
+    MatchEvent lastEvent;
+    uint32_t eventCount;
+
+    TripleBuffer<MatchSnapshot> snapshots;
+
+    void run();
+    void publish();
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Uniform grid broadphase over the pitch.
+//
+// Each entry is an integer id (obstacle or player index) with an axis-aligned
+// bounding box; it is filed under every cell the box touches.  A query
+// returns the ids whose cells overlap the query box, so narrowphase tests
+// only run against things that are actually nearby.
+//
+// Static geometry is inserted once.  Moving bodies call update() every step,
+// which only touches the cell lists when the body's cell range changed, so a
+// body that stays inside its cells costs a few integer compares.
+//
+// Boxes outside the grid are clamped onto the border cells, which keeps
+// balls inside the goal mouths (x < 0 or x > width) working.
+// ---------------------------------------------------------------------------
+class SpatialGrid {
+public:
+    SpatialGrid(float width = 40.0f, float height = 20.0f, float cellSize = 2.0f);
+
+    // Remove every entry.
+    void clear();
+
+    // File id under every cell overlapping the box.  Each id may be
+    // inserted once.
+    void insert(int id, float minX, float minY, float maxX, float maxY);
+
+    // Move an inserted id to a new box (inserts it if it is not in the grid).
+    void update(int id, float minX, float minY, float maxX, float maxY);
+
+    void remove(int id);
+
+    // Ids whose cells overlap the box, ascending and without duplicates.
+    // out is cleared first.  Callers resolving collisions in index order
+    // get the same order as a loop over every id.
+    void query(float minX, float minY, float maxX, float maxY,
+               std::vector<int> &out) const;
+
+    int getCols() const { return cols; }
+    int getRows() const { return rows; }
+    float getCellSize() const { return cellSize; }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;   // inclusive; x0 < 0 means not in the grid
+    };
+
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+
+    std::vector<std::vector<int>> cells;  // row-major, cols x rows
+    std::vector<CellRange> ranges;        // indexed by id
+
+    CellRange rangeFor(float minX, float minY, float maxX, float maxY) const;
+    void addToCells(int id, const CellRange &r);
+    void removeFromCells(int id, const CellRange &r);
+};
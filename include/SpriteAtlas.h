@@ -0,0 +1,119 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+class ShapeBatch;
+
+// Every sprite the game draws.  Images come from files; the white shapes
+// are drawn procedurally at build time so they can be tinted to any colour.
+enum class Sprite {
+    FIELD,     // pitch background image
+    BALL,      // ball image
+    PLAYER,    // player image (optional)
+    DISC,      // filled white circle
+    RING,      // white circle outline
+    MARKER,    // white triangle outline (active player indicator)
+    COUNT
+};
+
+// ============================================================================
+// Sprite atlas with pre-scaled levels.
+//
+// Images are added as surfaces, downscaled on the CPU to at most maxSize
+// and then halved again and again (alpha-weighted 2x2 box filter) down to
+// a few pixels; every level of every sprite is packed into one texture
+// page, uploaded once with SDL_UpdateTexture.  Nothing goes through a
+// render target at load time.
+//
+// draw() picks, for the size a sprite has on screen, the smallest level
+// that is still at least that big, so a 236 px ball drawn 12 px wide is
+// sampled from a 15 px copy instead of being minified on the GPU.  Since
+// the ball, the players and the markers all live on the same page,
+// drawing them is one texture bind and a run of tinted quads in a single
+// ShapeBatch flush.
+//
+// build() can be split the same way as FontAtlas loading: addImage(),
+// addShapes() and pack() are CPU-only and may run on a loader thread, and
+// upload() sends the packed page a band of rows at a time.
+//
+// The texture belongs to the renderer: release() it before the renderer
+// is destroyed.
+// ============================================================================
+class SpriteAtlas {
+public:
+    SpriteAtlas();
+    ~SpriteAtlas();
+    SpriteAtlas(const SpriteAtlas &) = delete;
+    SpriteAtlas &operator=(const SpriteAtlas &) = delete;
+
+    // Queue an image (any pixel format) for the next build(), scaled down
+    // to fit maxSize x maxSize.  The surface is copied, not kept.  Returns
+    // false for a null or empty surface.
+    bool addImage(Sprite id, SDL_Surface *surface, int maxSize);
+    // Queue the procedural DISC, RING and MARKER shapes.
+    void addShapes();
+
+    // Pack everything queued into one texture owned by renderer.  Queued
+    // images are dropped either way.  Returns false (and logs) on failure.
+    bool build(SDL_Renderer *renderer);
+    // First half of build(): pack the queued images into a page in system
+    // memory.  Returns false if nothing was queued.
+    bool pack();
+    // Second half: upload up to maxRows more rows of the page (creating
+    // the texture on the first call).  Returns false (and logs) on failure.
+    bool upload(SDL_Renderer *renderer, int maxRows);
+    // Rows of the page still to upload.
+    int getPendingRows() const { return page.empty() ? 0 : pageH - uploadedRows; }
+    void release();
+    // Exchange everything with other (publishing an atlas built elsewhere).
+    void swap(SpriteAtlas &other);
+
+    bool has(Sprite id) const {
+        return !levels[(int)id].empty() && texture != nullptr && page.empty();
+    }
+    SDL_Texture *getTexture() const { return texture; }
+    int getPageWidth() const { return pageW; }
+    int getPageHeight() const { return pageH; }
+
+    // Queue the sprite stretched over dst and multiplied by tint.  Does
+    // nothing if the sprite isn't in the atlas.
+    void draw(ShapeBatch &batch, Sprite id, const SDL_FRect &dst,
+              SDL_Color tint = SDL_Color{255, 255, 255, 255}) const;
+
+    // Texture coordinates of the level draw() would use for a dst of
+    // w x h pixels.
+    SDL_FRect uvFor(Sprite id, float w, float h) const;
+
+private:
+    // Smallest level side; halving stops before going below it.
+    static const int MIN_LEVEL = 4;
+
+    // Pixels in RGBA byte order.
+    struct Image {
+        int w = 0, h = 0;
+        std::vector<uint8_t> rgba;
+    };
+    struct Level {
+        int w, h;
+        SDL_FRect uv;
+    };
+    struct Pending {
+        Sprite id;
+        std::vector<Image> levels;   // largest first
+    };
+
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    int pageW, pageH;
+    std::vector<uint8_t> page;   // packed, not yet (fully) uploaded
+    int uploadedRows;
+    std::vector<Level> levels[(int)Sprite::COUNT];   // largest first
+    std::vector<Pending> pending;
+
+    static Image fromSurface(SDL_Surface *surface);
+    static Image resample(const Image &src, int w, int h);
+    static Image halve(const Image &src);
+    void addLevels(Sprite id, Image base);
+};
@@ -1,13 +1,15 @@
 #ifndef TEAMS_H
 #define TEAMS_H
 
-#include "SDLFramework.h"
+#include <SDL.h>
+#include <vector>
 #include "Vector.h"
+#include "PlayerStore.h"
 #include "Field.h"
 #include "Ball.h"
 
 // ---------------------------------------------------------------------------
-// Player & Team classes
+// Team class (players are stored structure-of-arrays in PlayerStore)
 // ---------------------------------------------------------------------------
 
 // Key binding structure for different control schemes
@@ -19,59 +21,53 @@ struct KeyBindings {
     SDL_Keycode swap; // this is SDLK_ not scancode
 };
 
-// Represents a controllable player on the field.
-class Player {
-public:
-    Vector pos;      // world coordinates (metres)
-    float speed;     // metres per second
-    float radius;    // collision radius in metres
-
-    Player(const Vector &start = Vector(), float spd = 20.0f, float rad = 0.8f)
-        : pos(start), speed(spd), radius(rad) {}
+// Input for one team for a single simulation step.  Decoupled from SDL's
+// keyboard state so the simulation can be driven headlessly (AI runs,
+// replays) as well as from the keyboard.
+struct TeamInput {
+    bool up;
+    bool down;
+    bool left;
+    bool right;
+    bool swap;  // swap key was pressed during this step
 
-    // Update with specific key bindings (for PvP support)
-    void update(float dt, const Uint8 *keyState, const KeyBindings &keys,
-                const Field *bounds = nullptr);
-
-    // existing update kept for backwards compatibility (uses WASD)
-    void update(float dt, const Uint8 *keyState, const Field *bounds = nullptr);
-    // low‑level movement function used by teams with custom controls
-    void move(float dx, float dy, float dt, const Field *bounds = nullptr);
-    // rendering: color is only used when tex is null.  If tex is provided
-    // it will be drawn centered on the player's position and tinted with
-    // SDL_SetTextureColorMod.
-    void render(SDL_Renderer *renderer, const Field &field, int screenW, int screenH,
-                SDL_Color color, SDL_Texture *tex = nullptr) const;
+    // Sample the movement keys of the given bindings from SDL's keyboard
+    // state.  The swap flag is edge-triggered and filled in from events.
+    static TeamInput fromKeyboard(const Uint8 *keyState, const KeyBindings &keys);
 };
 
 class Team {
 public:
-    Player p1;
-    Player p2;
-    int activeIndex; // 0 or 1
+    PlayerStore players;  // all players of this team (SoA)
+    int activeIndex;      // player controlled by the human / marked active
     int score;
     KeyBindings keys;
 
-    Team(const Vector &start1 = Vector(), const Vector &start2 = Vector(),
-         KeyBindings kb = {SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D, SDLK_e})
-        : p1(start1), p2(start2), activeIndex(0), score(0), keys(kb) {}
+    Team(const std::vector<Vector> &starts = std::vector<Vector>(),
+         KeyBindings kb = {SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D, SDLK_e});
 
-    // call from main loop to update the currently active player
+    int size() const { return players.size(); }
+
+    // call from main loop to move the currently active player
     void update(float dt, const Uint8 *keyState, const Field *bounds = nullptr);
+    void update(float dt, const TeamInput &input, const Field *bounds = nullptr);
     void handleEvent(const SDL_Event &e);
-    void render(SDL_Renderer *renderer, const Field &field, int screenW, int screenH,
+    // true if the event is a press of this team's swap key
+    bool isSwapEvent(const SDL_Event &e) const;
+
+    // Draws inactive players first, then the active one with an indicator
+    // arrow.  Colors tint the player discs, or the player sprite when the
+    // atlas has one, centred on each player.  Without an atlas the discs
+    // are drawn as geometry.
+    void render(ShapeBatch &batch, const Camera &camera,
                 SDL_Color activeColor, SDL_Color inactiveColor,
-                SDL_Texture *playerTex = nullptr) const;
+                const SpriteAtlas *sprites = nullptr) const;
 
-    Player &getActivePlayer();
-    const Player &getActivePlayer() const;
-    Player &getInactivePlayer();
-    const Player &getInactivePlayer() const;
+    // Hand control to the next player (wraps around)
     void swapActive();
 
-    // Reset both players to their starting positions
-    void resetPositions(const Vector &start1, const Vector &start2);
+    // Move every player back to its starting position (one per player)
+    void resetPositions(const std::vector<Vector> &starts);
 };
 
 #endif // TEAMS_H
-
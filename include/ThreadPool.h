@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Work-stealing thread pool.
+//
+// Every worker owns a task deque.  Tasks submitted from outside the pool are
+// dealt out round-robin; tasks submitted by a running task go to its own
+// worker's deque.  A worker takes its newest task first and, when its deque
+// is empty, steals the oldest task of another worker, so uneven task
+// lengths (a 5v5 match next to a 2v2 one) even out without a single shared
+// queue every thread contends on.
+// ============================================================================
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads <= 0 uses one worker per hardware thread.
+    explicit ThreadPool(int threads = 0);
+
+    // Finishes the queued tasks, then joins the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(Task task);
+
+    // Block until every submitted task has finished.  Must not be called
+    // from inside a task.
+    void wait();
+
+    int getThreadCount() const { return (int)workers.size(); }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;  // one per worker
+    std::vector<std::thread> workers;
+
+    std::mutex sleepLock;              // guards the two condition variables
+    std::condition_variable wakeUp;    // tasks were queued (or stopping)
+    std::condition_variable allDone;   // pending reached zero
+    std::atomic<int> queued;           // tasks sitting in some deque
+    std::atomic<int> pending;          // submitted and not yet finished
+    std::atomic<unsigned> nextQueue;   // round-robin target for submit()
+    bool stopping;
+
+    void workerLoop(int self);
+
+    // Own deque first (newest), then steal from the others (oldest).
+    bool takeTask(int self, Task &task);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+
+// ============================================================================
+// Lock-free triple buffer: one writer hands complete values to one reader.
+//
+// The writer fills back() and publish()es it; the reader calls acquire()
+// and reads front().  Each side owns one slot and they trade through the
+// third, so neither ever waits for the other: the writer can publish any
+// number of times between two reads (the reader just gets the newest) and
+// the reader can hold a value for as long as it likes.  A slot is reused
+// as-is, so a T that owns memory (vectors) keeps its capacity and steady
+// publishing does not allocate.
+//
+// The writer (and the reader) role may move to another thread only across
+// a synchronising operation such as starting or joining that thread.
+// ============================================================================
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), backIndex(2), frontIndex(0) {}
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // ---- Writer ----
+    T &back() { return slots[backIndex]; }
+    // Make back() the newest value and start on another slot.
+    void publish() {
+        backIndex = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // ---- Reader ----
+    // Take the newest published value if there is one since the last
+    // call; returns whether front() changed.
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T &front() const { return slots[frontIndex]; }
+
+private:
+    static const int INDEX = 3;   // slot number bits of middle
+    static const int FRESH = 4;   // middle holds a value the reader hasn't seen
+
+    T slots[3];
+    std::atomic<int> middle;      // the slot in transit, plus FRESH
+    int backIndex;                // writer's slot
+    int frontIndex;               // reader's slot
+};
@@ -39,4 +39,9 @@ public:
     float distanceTo(const Vector& other) const {
         return (*this - other).length();
     }
+
+    // linear interpolation: t = 0 gives *this, t = 1 gives other
+    Vector lerp(const Vector& other, float t) const {
+        return Vector(x + (other.x - x) * t, y + (other.y - y) * t);
+    }
 };
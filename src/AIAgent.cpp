@@ -1,46 +1,121 @@
 #include "../include/AIAgent.h"
+#include "../include/Obstacle.h"
+#include "../include/LaneTests.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 // ============================================================================
 // Construction
 // ============================================================================
-AIAgent::AIAgent(float reaction)
+AIAgent::AIAgent(float reaction, const AITuning &tuning)
     : reactionSpeed(reaction),
+      tuning(tuning),
       activeState(AIState::CHASE_BALL),
       supportState(AIState::FIND_SPACE),
       justPassed(false),
       justShot(false),
       shotTarget(),
+      passReceiver(-1),
       passCooldown(0.0f),
       shotCooldown(0.0f),
-      possessionTimer(0.0f) {}
+      possessionTimer(0.0f),
+      navigator(std::make_shared<Navigator>()) {}
 
 // ============================================================================
 // Player-to-Player collision resolution
 // ============================================================================
-void resolvePlayerCollisions(Player &a, Player &b) {
-    Vector diff = b.pos - a.pos;
-    float dist  = diff.length();
-    float minDist = a.radius + b.radius;
+// Push two overlapping circles apart, half the overlap each.
+static inline void separatePair(float &ax, float &ay, float ar,
+                                float &bx, float &by, float br) {
+    float dx = bx - ax;
+    float dy = by - ay;
+    float dist2 = dx * dx + dy * dy;
+    float minDist = ar + br;
+
+    if (dist2 < minDist * minDist && dist2 > 0.001f * 0.001f) {
+        float dist = std::sqrt(dist2);
+        float nx = dx / dist;
+        float ny = dy / dist;
+        float half = (minDist - dist) * 0.5f;
+        ax -= nx * half;
+        ay -= ny * half;
+        bx += nx * half;
+        by += ny * half;
+    }
+}
+
+void resolvePlayerCollisions(PlayerStore &p) {
+    const int n = p.size();
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            separatePair(p.x[i], p.y[i], p.radius[i], p.x[j], p.y[j], p.radius[j]);
+        }
+    }
+}
 
-    if (dist < minDist && dist > 0.001f) {
-        Vector normal = diff.normalized();
-        float overlap = minDist - dist;
-        // Push each player half the overlap distance apart
-        a.pos -= normal * (overlap * 0.5f);
-        b.pos += normal * (overlap * 0.5f);
+void resolvePlayerCollisions(PlayerStore &a, PlayerStore &b) {
+    const int na = a.size();
+    const int nb = b.size();
+    for (int i = 0; i < na; ++i) {
+        for (int j = 0; j < nb; ++j) {
+            separatePair(a.x[i], a.y[i], a.radius[i], b.x[j], b.y[j], b.radius[j]);
+        }
     }
 }
 
 void resolveAllPlayerCollisions(Team &team1, Team &team2) {
-    // All unique pairs among the 4 players:
-    resolvePlayerCollisions(team1.p1, team1.p2);
-    resolvePlayerCollisions(team2.p1, team2.p2);
-    resolvePlayerCollisions(team1.p1, team2.p1);
-    resolvePlayerCollisions(team1.p1, team2.p2);
-    resolvePlayerCollisions(team1.p2, team2.p1);
-    resolvePlayerCollisions(team1.p2, team2.p2);
+    // Teammates first, then every cross-team pair
+    resolvePlayerCollisions(team1.players);
+    resolvePlayerCollisions(team2.players);
+    resolvePlayerCollisions(team1.players, team2.players);
+}
+
+void resolveAllPlayerCollisions(Team &team1, Team &team2, SpatialGrid &grid) {
+    PlayerStore &a = team1.players;
+    PlayerStore &b = team2.players;
+    const int na = a.size();
+    const int total = na + b.size();
+
+    auto store = [&](int id) -> PlayerStore & { return id < na ? a : b; };
+    auto local = [na](int id) { return id < na ? id : id - na; };
+
+    for (int id = 0; id < total; ++id) {
+        PlayerStore &p = store(id);
+        int i = local(id);
+        float r = p.radius[i];
+        grid.update(id, p.x[i] - r, p.y[i] - r, p.x[i] + r, p.y[i] + r);
+    }
+
+    // Candidate pairs, keyed so that sorting reproduces the brute-force
+    // order: team 1 pairs, team 2 pairs, then cross-team pairs, each in
+    // (first, second) order.  The query box gets one radius of slack for
+    // pushes made earlier in the same pass.
+    static thread_local std::vector<int> nearby;
+    static thread_local std::vector<uint64_t> pairs;
+    pairs.clear();
+    for (int id = 0; id < total; ++id) {
+        PlayerStore &p = store(id);
+        int i = local(id);
+        float reach = 2.0f * p.radius[i];
+        grid.query(p.x[i] - reach, p.y[i] - reach, p.x[i] + reach, p.y[i] + reach, nearby);
+        for (int other : nearby) {
+            if (other <= id) continue;
+            uint64_t group = (other < na) ? 0 : (id >= na ? 1 : 2);
+            pairs.push_back((group << 60) | ((uint64_t)id << 30) | (uint64_t)other);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    for (uint64_t key : pairs) {
+        int id = (int)((key >> 30) & 0x3FFFFFFF);
+        int other = (int)(key & 0x3FFFFFFF);
+        PlayerStore &p = store(id);
+        PlayerStore &q = store(other);
+        int i = local(id);
+        int j = local(other);
+        separatePair(p.x[i], p.y[i], p.radius[i], q.x[j], q.y[j], q.radius[j]);
+    }
 }
 
 // ============================================================================
@@ -52,93 +127,90 @@ static float clampF(float v, float lo, float hi) {
     return v;
 }
 
-bool AIAgent::hasPossession(const Player &player, const Ball &ball) const {
-    float contactDist = player.radius + ball.radius;
-    return (player.pos - ball.pos).length() < contactDist;
+bool AIAgent::hasPossession(const PlayerStore &players, int i, const Ball &ball) const {
+    float contactDist = players.radius[i] + ball.radius;
+    return (players.getPos(i) - ball.pos).length() < contactDist;
 }
 
-void AIAgent::clampToField(Player &player, const Field &field) const {
-    player.pos.x = clampF(player.pos.x, player.radius,
-                           field.getWidth() - player.radius);
-    player.pos.y = clampF(player.pos.y, player.radius,
-                           field.getHeight() - player.radius);
+void AIAgent::clampToField(PlayerStore &players, int i, const Field &field) const {
+    float r = players.radius[i];
+    players.x[i] = clampF(players.x[i], r, field.getWidth() - r);
+    players.y[i] = clampF(players.y[i], r, field.getHeight() - r);
 }
 
-void AIAgent::seekWithArrival(float dt, Player &player, const Vector &target,
-                              float slowRadius) const {
-    Vector toTarget = target - player.pos;
+void AIAgent::seekWithArrival(float dt, PlayerStore &players, int i, const Vector &target,
+                              const Field &field, float slowRadius) {
+    Vector pos = players.getPos(i);
+    Vector toTarget = target - pos;
     float dist = toTarget.length();
 
     if (dist < 0.2f) return;
 
-    Vector dir = toTarget.normalized();
-    float moveSpeed = player.speed * reactionSpeed;
+    // Straight at the target if nothing is in the way, otherwise along the
+    // team's flow field round the obstacles
+    Vector heading = navigator->steer(field, pos, target, players.radius[i]) - pos;
+    Vector dir = (heading.lengthSquared() > 0.0001f) ? heading.normalized()
+                                                      : toTarget.normalized();
+    float moveSpeed = players.speed[i] * reactionSpeed;
 
     if (dist < slowRadius) {
         moveSpeed *= (dist / slowRadius);
     }
 
-    player.pos += dir * moveSpeed * dt;
+    players.translate(i, dir * moveSpeed * dt);
 }
 
-float AIAgent::pointToSegmentDistance(const Vector &point,
-                                     const Vector &segA,
-                                     const Vector &segB) const {
-    Vector ab = segB - segA;
-    Vector ap = point - segA;
-    float t = ab.dot(ap) / std::max(0.0001f, ab.dot(ab));
-    t = clampF(t, 0.0f, 1.0f);
-    Vector closest = segA + ab * t;
-    return (point - closest).length();
+// Branch-free loop over the opponents' position arrays so it vectorises.
+// Each opponent is projected onto the segment, the projection clamped to
+// its ends, and the distance taken to that closest point; one opponent
+// per lane.
+float AIAgent::minOpponentDistanceToSegment(const Vector &from, const Vector &to,
+                                            const PlayerStore &opponents) const {
+    const float abx = to.x - from.x;
+    const float aby = to.y - from.y;
+    const float len2 = std::max(0.0001f, abx * abx + aby * aby);
+    const float *ox = opponents.x.data();
+    const float *oy = opponents.y.data();
+    const int n = opponents.size();
+
+    float best2 = 1e30f;
+    for (int i = 0; i < n; ++i) {
+        float t = (abx * (ox[i] - from.x) + aby * (oy[i] - from.y)) / len2;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        float dx = ox[i] - (from.x + abx * t);
+        float dy = oy[i] - (from.y + aby * t);
+        float d2 = dx * dx + dy * dy;
+        best2 = d2 < best2 ? d2 : best2;
+    }
+    return std::sqrt(best2);
 }
 
 bool AIAgent::isPassingLaneClear(const Vector &from, const Vector &to,
-                                 const Team &opponentTeam,
+                                 const Field &field,
+                                 const PlayerStore &opponents,
                                  float clearance) const {
-    float d1 = pointToSegmentDistance(opponentTeam.p1.pos, from, to);
-    float d2 = pointToSegmentDistance(opponentTeam.p2.pos, from, to);
-    return (d1 > clearance && d2 > clearance);
+    return minOpponentDistanceToSegment(from, to, opponents) > clearance &&
+           field.isPathClear(from, to, Field::BALL_CLEARANCE);
 }
 
 // ============================================================================
 // Shooting Angle Calculation
 // ============================================================================
-// Calculates the angle (in radians) that the goal opening subtends from the
+// The angle (in radians) the opponents' goal opening subtends from the
 // shooter's viewpoint.  A larger angle means a better/easier shot.
-//
-//   θ = atan2(dy_top, dx) - atan2(dy_bot, dx)
-//
-// where top/bot are the two goal-post positions.
 float AIAgent::calculateShootingAngle(const Vector &shooterPos,
                                       const Field &field,
                                       bool isLeftSide) const {
     // We shoot at the OPPONENT'S goal
-    float goalX = isLeftSide ? field.getWidth() : 0.0f;
-    float goalTop = field.getGoalTop();
-    float goalBot = field.getGoalBottom();
-
-    Vector postTop(goalX, goalTop);
-    Vector postBot(goalX, goalBot);
-
-    Vector toTop = postTop - shooterPos;
-    Vector toBot = postBot - shooterPos;
-
-    float angleTop = std::atan2(toTop.y, toTop.x);
-    float angleBot = std::atan2(toBot.y, toBot.x);
-
-    float angle = std::abs(angleTop - angleBot);
-    // Normalize to [0, PI]
-    if (angle > 3.14159f) angle = 2.0f * 3.14159f - angle;
-
-    return angle;
+    return field.goalAngle(shooterPos, isLeftSide ? field.getWidth() : 0.0f);
 }
 
 // Check if a shot line is clear of opponents
 bool AIAgent::isShotClear(const Vector &from, const Vector &target,
-                          const Team &opponentTeam, float clearance) const {
-    float d1 = pointToSegmentDistance(opponentTeam.p1.pos, from, target);
-    float d2 = pointToSegmentDistance(opponentTeam.p2.pos, from, target);
-    return (d1 > clearance && d2 > clearance);
+                          const Field &field,
+                          const PlayerStore &opponents, float clearance) const {
+    return minOpponentDistanceToSegment(from, target, opponents) > clearance &&
+           field.isPathClear(from, target, Field::BALL_CLEARANCE);
 }
 
 // Find the best shot target within the goal opening
@@ -147,7 +219,7 @@ bool AIAgent::isShotClear(const Vector &from, const Vector &target,
 Vector AIAgent::findBestShotTarget(const Vector &shooterPos,
                                    const Field &field,
                                    bool isLeftSide,
-                                   const Team &opponentTeam) const {
+                                   const PlayerStore &opponents) const {
     float goalX = isLeftSide ? field.getWidth() : 0.0f;
     float goalTop = field.getGoalTop();
     float goalBot = field.getGoalBottom();
@@ -155,18 +227,28 @@ Vector AIAgent::findBestShotTarget(const Vector &shooterPos,
     Vector bestTarget(goalX, field.getHeight() / 2.0f);
     float bestScore = -9999.0f;
 
-    // Sample 9 points across the goal opening
-    int samples = 9;
+    // Sample 9 points across the goal opening, and measure every shot
+    // line's distance from the opponents in one batch
+    const int samples = 9;
+    static thread_local LaneBatch lanes;
+    lanes.clear();
     for (int i = 0; i < samples; ++i) {
         float t = (float)i / (float)(samples - 1);
-        float y = goalTop + t * (goalBot - goalTop);
+        lanes.add(shooterPos, Vector(goalX, goalTop + t * (goalBot - goalTop)));
+    }
+    float oppDist[samples];
+    laneDistances(lanes, opponents.x.data(), opponents.y.data(), opponents.size(), oppDist);
+
+    for (int i = 0; i < samples; ++i) {
+        float y = lanes.by[i];
         Vector candidate(goalX, y);
 
+        // An obstacle in the way blocks this target outright
+        if (!field.isPathClear(shooterPos, candidate, Field::BALL_CLEARANCE)) continue;
+
         // Score = min distance of this shot line from opponents
         // Higher = the shot is harder to block
-        float d1 = pointToSegmentDistance(opponentTeam.p1.pos, shooterPos, candidate);
-        float d2 = pointToSegmentDistance(opponentTeam.p2.pos, shooterPos, candidate);
-        float oppClearance = std::min(d1, d2);
+        float oppClearance = oppDist[i];
 
         // Prefer center of goal slightly (easier to score)
         float centerY = (goalTop + goalBot) / 2.0f;
@@ -188,9 +270,7 @@ Vector AIAgent::findBestShotTarget(const Vector &shooterPos,
 // Role Assignment
 // ============================================================================
 int AIAgent::assignRoles(const Team &team, const Ball &ball) const {
-    float d1 = (team.p1.pos - ball.pos).length();
-    float d2 = (team.p2.pos - ball.pos).length();
-    return (d1 <= d2) ? 0 : 1;
+    return team.players.nearestTo(ball.pos);
 }
 
 // ============================================================================
@@ -204,24 +284,56 @@ void AIAgent::updateTeam(float dt, Team &team, const Ball &ball,
     justPassed = false;
     justShot   = false;
 
-    int activeIdx = assignRoles(team, ball);
-    Player &active  = (activeIdx == 0) ? team.p1 : team.p2;
-    Player &support = (activeIdx == 0) ? team.p2 : team.p1;
+    PlayerStore &players = team.players;
+    int active = assignRoles(team, ball);
+    if (active < 0) return;
+
+    updateInfluence(field, isLeftSide, players, opponentTeam.players);
+    updateActive(dt, players, active, ball, field, isLeftSide, opponentTeam.players);
 
-    updateActive(dt, active, support, ball, field, isLeftSide, opponentTeam);
-    updateSupport(dt, support, active, ball, field, isLeftSide, opponentTeam);
+    // The supporters nearest our goal defend if needed, by distance to it
+    // (lowest index on ties); the rest look for space
+    static thread_local std::vector<int> order;
+    static thread_local std::vector<char> defending;
+    order.clear();
+    for (int i = 0; i < players.size(); ++i) {
+        if (i != active) order.push_back(i);
+    }
+    defending.assign(players.size(), 0);
+    int defenders = defendersNeeded((int)order.size(), ball, field, isLeftSide);
+    if (defenders > 0) {
+        const float ownGoalX = isLeftSide ? 0.0f : field.getWidth();
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return std::abs(players.x[a] - ownGoalX) < std::abs(players.x[b] - ownGoalX);
+        });
+        for (int k = 0; k < defenders; ++k) defending[order[k]] = 1;
+    }
+
+    // Supporters spread out from the active player and from each other
+    std::vector<Vector> spacing;
+    spacing.push_back(players.getPos(active));
+    for (int i = 0; i < players.size(); ++i) {
+        if (i == active) continue;
+        if (defending[i]) {
+            updateDefender(dt, players, i, spacing, ball, field);
+        } else {
+            updateSupport(dt, players, i, spacing, ball, field, isLeftSide,
+                          opponentTeam.players);
+        }
+    }
 
-    clampToField(active, field);
-    clampToField(support, field);
+    for (int i = 0; i < players.size(); ++i) {
+        clampToField(players, i, field);
+    }
 }
 
 // ============================================================================
 // Active Player update  (now includes SHOOT decision)
 // ============================================================================
-void AIAgent::updateActive(float dt, Player &active, Player &support,
+void AIAgent::updateActive(float dt, PlayerStore &players, int active,
                            const Ball &ball, const Field &field,
-                           bool isLeftSide, const Team &opponentTeam) {
-    bool possess = hasPossession(active, ball);
+                           bool isLeftSide, const PlayerStore &opponents) {
+    bool possess = hasPossession(players, active, ball);
 
     if (possess) {
         possessionTimer += dt;
@@ -236,41 +348,73 @@ void AIAgent::updateActive(float dt, Player &active, Player &support,
     if (!possess) {
         // ---- CHASE BALL ----
         activeState = AIState::CHASE_BALL;
-        chaseBall(dt, active, ball, field, isLeftSide);
+        chaseBall(dt, players, active, ball, field, isLeftSide);
+    } else if (tuning.planBudget > 0.0f) {
+        planActive(dt, players, active, ball, field, isLeftSide, opponents);
     } else {
         // We have the ball — decide: SHOOT, PASS, or DRIBBLE
-        float distToGoal = (active.pos - goalCenter).length();
+        Vector activePos = players.getPos(active);
+        float distToGoal = (activePos - goalCenter).length();
 
         // 1. Evaluate shooting opportunity
-        float shootAngle = calculateShootingAngle(active.pos, field, isLeftSide);
-        Vector bestShotTarget = findBestShotTarget(active.pos, field, isLeftSide, opponentTeam);
-        bool shotClear = isShotClear(active.pos, bestShotTarget, opponentTeam, 1.5f);
-
-        // Shooting thresholds:
-        //   - angle > 0.15 rad (~8.6°)  = decent angle
-        //   - angle > 0.30 rad (~17°)   = good angle
-        //   - distToGoal < 15m          = in shooting range
-        bool goodShot = (shootAngle > 0.15f) && shotClear && (distToGoal < 18.0f);
-        bool greatShot = (shootAngle > 0.30f) && shotClear && (distToGoal < 12.0f);
-
-        // 2. Evaluate passing opportunity
-        float distToSupport = (active.pos - support.pos).length();
-        bool laneClear = isPassingLaneClear(active.pos, support.pos, opponentTeam, 2.5f);
-        bool supportAheadOfUs;
-        if (isLeftSide) {
-            supportAheadOfUs = (support.pos.x > active.pos.x + 2.0f);
-        } else {
-            supportAheadOfUs = (support.pos.x < active.pos.x - 2.0f);
+        float shootAngle = calculateShootingAngle(activePos, field, isLeftSide);
+        Vector bestShotTarget = findBestShotTarget(activePos, field, isLeftSide, opponents);
+        bool shotClear = isShotClear(activePos, bestShotTarget, field, opponents,
+                                     tuning.shotClearance);
+
+        // Shooting thresholds (defaults):
+        //   - angle > 0.15 rad (~8.6°) within 18m = decent shot
+        //   - angle > 0.30 rad (~17°)  within 12m = great shot
+        bool goodShot = (shootAngle > tuning.goodShotAngle) && shotClear &&
+                        (distToGoal < tuning.goodShotRange);
+        bool greatShot = (shootAngle > tuning.greatShotAngle) && shotClear &&
+                         (distToGoal < tuning.greatShotRange);
+
+        // 2. Evaluate passing opportunity: the most advanced teammate that
+        //    has a clear lane and is in range
+        float closestOpp = influence.pressure(activePos);
+        bool underPressure = (closestOpp < tuning.pressureDistance);
+
+        // Opponent check of every teammate's lane in one batch (lane i
+        // goes to player i; the active player's own lane is never used)
+        static thread_local LaneBatch lanes;
+        static thread_local std::vector<uint64_t> clearLanes;
+        lanes.clear();
+        for (int i = 0; i < players.size(); ++i) {
+            lanes.add(activePos, players.getPos(i));
+        }
+        clearLanes.resize((players.size() + 63) / 64);
+        laneClearMask(lanes, opponents.x.data(), opponents.y.data(), opponents.size(),
+                      tuning.passLaneClearance, clearLanes.data());
+
+        int receiver = -1;
+        float receiverAdvance = 0.0f;
+        for (int i = 0; i < players.size(); ++i) {
+            if (i == active) continue;
+            Vector supportPos = players.getPos(i);
+            float distToSupport = (activePos - supportPos).length();
+            bool laneClear = laneBit(clearLanes.data(), i) &&
+                             field.isPathClear(activePos, supportPos, Field::BALL_CLEARANCE);
+            bool supportAheadOfUs;
+            if (isLeftSide) {
+                supportAheadOfUs = (supportPos.x > activePos.x + 2.0f);
+            } else {
+                supportAheadOfUs = (supportPos.x < activePos.x - 2.0f);
+            }
+            bool open = laneClear &&
+                        (distToSupport > tuning.passMinDistance &&
+                         distToSupport < tuning.passMaxDistance) &&
+                        (supportAheadOfUs ||
+                         (underPressure && distToSupport > tuning.pressurePassDistance));
+            float advance = isLeftSide ? supportPos.x : -supportPos.x;
+            if (open && (receiver < 0 || advance > receiverAdvance)) {
+                receiver = i;
+                receiverAdvance = advance;
+            }
         }
-        float distOpp1 = (active.pos - opponentTeam.p1.pos).length();
-        float distOpp2 = (active.pos - opponentTeam.p2.pos).length();
-        float closestOpp = std::min(distOpp1, distOpp2);
-        bool underPressure = (closestOpp < 4.0f);
 
         bool shouldPass = (passCooldown <= 0.0f) &&
-                           laneClear &&
-                           (distToSupport > 4.0f && distToSupport < 25.0f) &&
-                           (supportAheadOfUs || (underPressure && distToSupport > 5.0f)) &&
+                           receiver >= 0 &&
                            possessionTimer > 0.3f;
 
         // ---- Decision priority: SHOOT > PASS > DRIBBLE ----
@@ -280,76 +424,143 @@ void AIAgent::updateActive(float dt, Player &active, Player &support,
             activeState = AIState::SHOOT;
             justShot    = true;
             shotTarget  = bestShotTarget;
-            shotCooldown = 2.0f;
+            shotCooldown = tuning.shotCooldown;
             possessionTimer = 0.0f;
         } else if (shouldPass) {
             activeState = AIState::PASS;
             justPassed  = true;
-            passCooldown = 1.5f;
+            passReceiver = receiver;
+            passCooldown = tuning.passCooldown;
             possessionTimer = 0.0f;
         } else {
             // Dribble — but steer toward a better shooting position
             activeState = AIState::DRIBBLE;
-            dribble(dt, active, ball, field, isLeftSide);
+            dribble(dt, players, active, field, isLeftSide);
+        }
+    }
+}
+
+// ============================================================================
+// Active player with the rollout planner
+// ============================================================================
+void AIAgent::planActive(float dt, PlayerStore &players, int active,
+                         const Ball &ball, const Field &field,
+                         bool isLeftSide, const PlayerStore &opponents) {
+    // The same options the fixed priority has, under the same cooldowns,
+    // but without its judgement of which are good: the rollouts make that
+    Vector activePos = players.getPos(active);
+    planner.clearActions();
+    planner.addAction({PlanAction::DRIBBLE, dribbleTarget(activePos, field, isLeftSide)});
+
+    Vector goalCenter(isLeftSide ? field.getWidth() : 0.0f, field.getHeight() / 2.0f);
+    if (shotCooldown <= 0.0f && possessionTimer > 0.2f &&
+        (activePos - goalCenter).length() < tuning.goodShotRange) {
+        planner.addAction({PlanAction::SHOOT,
+                           findBestShotTarget(activePos, field, isLeftSide, opponents)});
+    }
+    if (passCooldown <= 0.0f && possessionTimer > 0.3f) {
+        for (int i = 0; i < players.size(); ++i) {
+            if (i == active) continue;
+            Vector supportPos = players.getPos(i);
+            float dist = (supportPos - activePos).length();
+            if (dist > tuning.passMinDistance && dist < tuning.passMaxDistance &&
+                field.isPathClear(activePos, supportPos, Field::BALL_CLEARANCE)) {
+                planner.addAction({PlanAction::PASS, supportPos, i});
+            }
         }
     }
+
+    int choice = planner.choose(ball, field, influence, players, active, opponents, isLeftSide,
+                                reactionSpeed, tuning.planBudget, tuning.planRollouts);
+    const PlanAction &action = planner.getActions()[choice];
+    if (action.kind == PlanAction::SHOOT) {
+        activeState = AIState::SHOOT;
+        justShot    = true;
+        shotTarget  = action.target;
+        shotCooldown = tuning.shotCooldown;
+        possessionTimer = 0.0f;
+    } else if (action.kind == PlanAction::PASS) {
+        activeState = AIState::PASS;
+        justPassed  = true;
+        passReceiver = action.receiver;
+        passCooldown = tuning.passCooldown;
+        possessionTimer = 0.0f;
+    } else {
+        activeState = AIState::DRIBBLE;
+        dribble(dt, players, active, field, isLeftSide);
+    }
 }
 
 // ============================================================================
 // Chase Ball
 // ============================================================================
-void AIAgent::chaseBall(float dt, Player &player, const Ball &ball,
+void AIAgent::chaseBall(float dt, PlayerStore &players, int i, const Ball &ball,
                         const Field &field, bool isLeftSide) {
+    Vector pos = players.getPos(i);
+
+    // Run for the earliest point the ball can be reached at rather than
+    // where it is now (or where it is, if it goes in before then)
+    Vector ballPos = ball.pos;
+    predictor.predict(ball, field, dt);
+    float when;
+    Vector where;
+    if (predictor.intercept(pos, players.speed[i] * reactionSpeed,
+                            players.radius[i] + ball.radius, when, where)) {
+        ballPos = where;
+    }
+
     Vector target;
     float approachOffset = 1.5f;
     if (isLeftSide) {
-        target = Vector(ball.pos.x - approachOffset, ball.pos.y);
+        target = Vector(ballPos.x - approachOffset, ballPos.y);
     } else {
-        target = Vector(ball.pos.x + approachOffset, ball.pos.y);
+        target = Vector(ballPos.x + approachOffset, ballPos.y);
     }
 
-    float distToBall = (player.pos - ball.pos).length();
-    bool behindBall = isLeftSide ? (player.pos.x < ball.pos.x - 0.5f)
-                                  : (player.pos.x > ball.pos.x + 0.5f);
+    float distToBall = (pos - ballPos).length();
+    bool behindBall = isLeftSide ? (pos.x < ballPos.x - 0.5f)
+                                  : (pos.x > ballPos.x + 0.5f);
     if (behindBall || distToBall < 2.0f) {
-        target = ball.pos;
+        target = ballPos;
     }
 
-    seekWithArrival(dt, player, target, 2.0f);
+    seekWithArrival(dt, players, i, target, field, 2.0f);
 }
 
 // ============================================================================
 // Dribble — now steers toward a position with a better shooting angle
 // ============================================================================
-void AIAgent::dribble(float dt, Player &player, const Ball &ball,
-                      const Field &field, bool isLeftSide) {
-    float goalX = isLeftSide ? field.getWidth() : 0.0f;
+Vector AIAgent::dribbleTarget(const Vector &pos, const Field &field, bool isLeftSide) const {
     float goalY = field.getHeight() / 2.0f;
-    Vector goalCenter(goalX, goalY);
 
     // Move toward a point between current position and goal
     // but biased toward the lateral center of the field to open up the angle
-    float targetY = goalY * 0.7f + player.pos.y * 0.3f; // drift toward center-Y
+    float targetY = goalY * 0.7f + pos.y * 0.3f; // drift toward center-Y
     float targetX;
     if (isLeftSide) {
-        targetX = player.pos.x + 3.0f; // advance right
+        targetX = pos.x + 3.0f; // advance right
         targetX = std::min(targetX, field.getWidth() - 3.0f);
     } else {
-        targetX = player.pos.x - 3.0f; // advance left
+        targetX = pos.x - 3.0f; // advance left
         targetX = std::max(targetX, 3.0f);
     }
 
-    Vector target(targetX, targetY);
-    seekWithArrival(dt, player, target, 2.0f);
+    return Vector(targetX, targetY);
+}
+
+void AIAgent::dribble(float dt, PlayerStore &players, int i, const Field &field,
+                      bool isLeftSide) {
+    seekWithArrival(dt, players, i, dribbleTarget(players.getPos(i), field, isLeftSide), field,
+                    2.0f);
 }
 
 // ============================================================================
 // Pass execution
 // ============================================================================
-void AIAgent::executePass(Ball &ball, const Player &passer, const Player &receiver) {
+void AIAgent::executePass(Ball &ball, const Vector &receiverPos) {
     float k = 1.2f;
-    Vector passDir = (receiver.pos - ball.pos).normalized();
-    float passDist = (receiver.pos - ball.pos).length();
+    Vector passDir = (receiverPos - ball.pos).normalized();
+    float passDist = (receiverPos - ball.pos).length();
     float passSpeed = std::min(25.0f, std::max(12.0f, passDist * k));
     ball.vel = passDir * passSpeed;
 }
@@ -357,88 +568,298 @@ void AIAgent::executePass(Ball &ball, const Player &passer, const Player &receiv
 // ============================================================================
 // Support Player update
 // ============================================================================
-void AIAgent::updateSupport(float dt, Player &support, const Player &active,
-                            const Ball &ball, const Field &field,
-                            bool isLeftSide, const Team &opponentTeam) {
-    Vector optimalPos = findOptimalReceivingPoint(support, active, ball, field,
-                                                  isLeftSide, opponentTeam);
-    float distToOptimal = (support.pos - optimalPos).length();
+void AIAgent::updateSupport(float dt, PlayerStore &players, int support,
+                            std::vector<Vector> &spacing, const Ball &ball,
+                            const Field &field, bool isLeftSide,
+                            const PlayerStore &opponents) {
+    Vector supportPos = players.getPos(support);
+    Vector optimalPos = findOptimalReceivingPoint(supportPos, spacing, ball, field,
+                                                  isLeftSide, opponents);
+    spacing.push_back(optimalPos);
+    float distToOptimal = (supportPos - optimalPos).length();
 
     if (distToOptimal > 1.0f) {
         supportState = AIState::FIND_SPACE;
-        seekWithArrival(dt, support, optimalPos, 3.0f);
+        seekWithArrival(dt, players, support, optimalPos, field, 3.0f);
     } else {
         supportState = AIState::WAIT_RECEIVE;
-        Vector toBall = (ball.pos - support.pos).normalized();
-        support.pos += toBall * 0.5f * dt;
+        Vector toBall = (ball.pos - supportPos).normalized();
+        players.translate(support, toBall * 0.5f * dt);
     }
 }
 
 // ============================================================================
-// Find optimal receiving position
+// Defending
 // ============================================================================
-Vector AIAgent::findOptimalReceivingPoint(const Player &support,
-                                          const Player &active,
-                                          const Ball &ball,
-                                          const Field &field,
-                                          bool isLeftSide,
-                                          const Team &opponentTeam) const {
-    float bestScore = -9999.0f;
-    Vector bestPos = support.pos;
+void AIAgent::updateInfluence(const Field &field, bool isLeftSide, const PlayerStore &team,
+                              const PlayerStore &opponents) {
+    influence.build(field, isLeftSide, team, opponents);
+}
 
-    float goalX = isLeftSide ? field.getWidth() : 0.0f;
-    float goalY = field.getHeight() / 2.0f;
+int AIAgent::defendersNeeded(int supporters, const Ball &ball, const Field &field,
+                             bool isLeftSide) const {
+    if (supporters == 0) return 0;
+    // The opponents are on the ball: one of them is nearer to it than any of us
+    if (influence.pressure(ball.pos) >= influence.coverage(ball.pos)) return 0;
+    // ...in our half
+    const Vector ownGoal(isLeftSide ? 0.0f : field.getWidth(), field.getHeight() / 2.0f);
+    if (std::abs(ball.pos.x - ownGoal.x) > field.getWidth() / 2.0f) return 0;
+    // ...and nobody stands in the way to our goal yet
+    if (influence.coverage(ownGoal.lerp(ball.pos, 0.5f)) < 2.0f) return 0;
+    return std::max(1, supporters / 2);
+}
 
-    float margin = 2.0f;
-    float stepX = 3.0f;
-    float stepY = 3.0f;
+void AIAgent::updateDefender(float dt, PlayerStore &players, int i,
+                             std::vector<Vector> &spacing, const Ball &ball,
+                             const Field &field) {
+    Vector spot = influence.defendSpot(ball.pos, players.getPos(i), spacing);
+    spacing.push_back(spot);
+    supportState = AIState::DEFEND;
+    seekWithArrival(dt, players, i, spot, field, 2.0f);
+}
 
-    float searchMinX = margin;
-    float searchMaxX = field.getWidth() - margin;
-    float searchMinY = margin;
-    float searchMaxY = field.getHeight() - margin;
+// ============================================================================
+// Find optimal receiving position
+// ============================================================================
+// Candidate spots keep this far from the touchlines, and sit on a grid of
+// RECEIVE_STEP metres.  The coarse pass scores every COARSE_STRIDE-th spot
+// (the 3 m grid the search used to be limited to); the best REFINE_SEEDS
+// coarse spots then have their neighbourhood scored at full resolution.
+static const float RECEIVE_MARGIN = 2.0f;
+static const float RECEIVE_STEP   = 0.5f;
+static const int   COARSE_STRIDE  = 6;
+static const int   REFINE_SEEDS   = 3;
+
+// Opponents must be this far from the ball->spot lane for a pass to count.
+static const float RECEIVE_LANE_CLEARANCE = 2.0f;
+
+// Line of sight is retested once the ball has moved this far (one cell of
+// the field's distance field) from where it was last tested.
+static const float LOS_RETEST = 0.1f;
+
+// Retake the lane snapshot once ball + opponents drifted this far from it.
+static const float SNAPSHOT_DRIFT = 1.0f;
+
+void AIAgent::prepareReceivingGrid(const Field &field, bool isLeftSide) {
+    ReceivingGrid &g = receivingGrid;
+    if (g.revision == field.getRevision() &&
+        g.width == field.getWidth() && g.height == field.getHeight() &&
+        g.isLeftSide == isLeftSide && !g.cells.empty()) {
+        return;
+    }
 
-    for (float cx = searchMinX; cx <= searchMaxX; cx += stepX) {
-        for (float cy = searchMinY; cy <= searchMaxY; cy += stepY) {
-            Vector candidate(cx, cy);
+    g.revision = field.getRevision();
+    g.width = field.getWidth();
+    g.height = field.getHeight();
+    g.isLeftSide = isLeftSide;
+    g.cols = (int)std::floor((g.width - 2.0f * RECEIVE_MARGIN) / RECEIVE_STEP + 1e-3f) + 1;
+    g.rows = (int)std::floor((g.height - 2.0f * RECEIVE_MARGIN) / RECEIVE_STEP + 1e-3f) + 1;
+    g.cells.assign(g.cols * g.rows, ReceivingCell());
+    g.snapshot++;   // lane terms of the old layout are meaningless now
 
-            float dOpp1 = (candidate - opponentTeam.p1.pos).length();
-            float dOpp2 = (candidate - opponentTeam.p2.pos).length();
-            float oppScore = std::min(dOpp1, dOpp2);
+    float goalY = field.getHeight() / 2.0f;
+    for (int r = 0; r < g.rows; ++r) {
+        for (int c = 0; c < g.cols; ++c) {
+            Vector candidate(RECEIVE_MARGIN + c * RECEIVE_STEP,
+                             RECEIVE_MARGIN + r * RECEIVE_STEP);
+            ReceivingCell &cell = g.cells[r * g.cols + c];
 
-            bool laneClear = isPassingLaneClear(ball.pos, candidate, opponentTeam, 2.0f);
-            float laneScore = laneClear ? 5.0f : -10.0f;
+            // Nowhere to stand inside or against an obstacle
+            cell.standable = field.obstacleDistance(candidate) >= Field::STAND_CLEARANCE;
 
             float advanceScore;
             if (isLeftSide) {
-                advanceScore = cx / field.getWidth();
+                advanceScore = candidate.x / field.getWidth();
             } else {
-                advanceScore = 1.0f - (cx / field.getWidth());
+                advanceScore = 1.0f - (candidate.x / field.getWidth());
             }
             advanceScore *= 8.0f;
 
-            float dToActive = (candidate - active.pos).length();
-            float spreadScore = (dToActive > 6.0f) ? 3.0f : (dToActive / 6.0f) * 3.0f;
+            float dToGoalCenter = std::abs(candidate.y - goalY);
+            float angleScore = (1.0f - dToGoalCenter / (field.getHeight() / 2.0f)) * 3.0f;
 
-            float dToBall = (candidate - ball.pos).length();
-            float reachScore = (dToBall < 20.0f) ? 2.0f : -2.0f * (dToBall / field.getWidth());
+            // Bonus for positions that have a good (unobstructed) shooting angle
+            float shotAngleScore = influence.shotValue(candidate) * 5.0f; // radians -> score
 
-            float dToGoalCenter = std::abs(cy - goalY);
-            float angleScore = (1.0f - dToGoalCenter / (field.getHeight() / 2.0f)) * 3.0f;
+            cell.staticScore = advanceScore + angleScore + shotAngleScore;
+            cell.laneSnapshot = -1;
+            cell.laneOppDist = 0.0f;
+            cell.losTested = false;
+            cell.losClear = false;
+        }
+    }
+}
 
-            // New: bonus for positions that have a good shooting angle
-            float shotAngle = calculateShootingAngle(candidate, field, isLeftSide);
-            float shotAngleScore = shotAngle * 5.0f; // radians -> score
+float AIAgent::updateLaneSnapshot(const Ball &ball, const PlayerStore &opponents) {
+    ReceivingGrid &g = receivingGrid;
+    float drift = 1e30f;
+    if (g.snapOpponents.size() == opponents.size()) {
+        // A lane's distance to the nearest opponent changes by at most how
+        // far its end (the ball) and the opponents have moved
+        float oppDrift = 0.0f;
+        for (int i = 0; i < opponents.size(); ++i) {
+            oppDrift = std::max(oppDrift, (opponents.getPos(i) - g.snapOpponents.getPos(i)).length());
+        }
+        drift = (ball.pos - g.snapBall).length() + oppDrift;
+    }
+    if (drift > SNAPSHOT_DRIFT) {
+        g.snapshot++;
+        g.snapBall = ball.pos;
+        g.snapOpponents = opponents;
+        drift = 0.0f;
+    }
+    // Slack for float rounding in the distance computations
+    return drift + 1e-4f;
+}
 
-            float totalScore = oppScore + laneScore + advanceScore +
-                               spreadScore + reachScore + angleScore + shotAngleScore;
+float AIAgent::scoreReceivingCell(int col, int row, float drift,
+                                  const std::vector<Vector> &spacing,
+                                  const Ball &ball, const Field &field,
+                                  const PlayerStore &opponents) {
+    ReceivingGrid &g = receivingGrid;
+    ReceivingCell &cell = g.cells[row * g.cols + col];
+    if (!cell.standable) return -1e30f;
+
+    Vector candidate(RECEIVE_MARGIN + col * RECEIVE_STEP,
+                     RECEIVE_MARGIN + row * RECEIVE_STEP);
+
+    // ---- Passing lane: opponents first, obstacles only if that passes ----
+    // (laneOppDist is current: refreshReceivingLanes ran on this cell)
+    bool laneClear;
+    if (std::abs(cell.laneOppDist - RECEIVE_LANE_CLEARANCE) > drift) {
+        // Nobody has moved enough to change the answer
+        laneClear = cell.laneOppDist > RECEIVE_LANE_CLEARANCE;
+    } else {
+        laneClear = minOpponentDistanceToSegment(ball.pos, candidate, opponents) >
+                    RECEIVE_LANE_CLEARANCE;
+    }
+    if (laneClear) {
+        if (!cell.losTested || (ball.pos - cell.losBall).length() > LOS_RETEST) {
+            cell.losClear = field.isPathClear(ball.pos, candidate, Field::BALL_CLEARANCE);
+            cell.losBall = ball.pos;
+            cell.losTested = true;
+        }
+        laneClear = cell.losClear;
+    }
+    float laneScore = laneClear ? 5.0f : -10.0f;
+
+    float oppScore = influence.pressure(candidate);
+
+    // Keep away from the active player and other supporters' targets
+    float dToMate = 1e30f;
+    for (const Vector &p : spacing) {
+        dToMate = std::min(dToMate, (candidate - p).length());
+    }
+    float spreadScore = (dToMate > 6.0f) ? 3.0f : (dToMate / 6.0f) * 3.0f;
+
+    float dToBall = (candidate - ball.pos).length();
+    float reachScore = (dToBall < 20.0f) ? 2.0f : -2.0f * (dToBall / field.getWidth());
+
+    return oppScore + laneScore + cell.staticScore + spreadScore + reachScore;
+}
+
+void AIAgent::refreshReceivingLanes(const std::vector<int> &cellIds) {
+    ReceivingGrid &g = receivingGrid;
+    static thread_local LaneBatch lanes;
+    static thread_local std::vector<int> stale;
+    static thread_local std::vector<float> dist;
+    lanes.clear();
+    stale.clear();
+    for (int id : cellIds) {
+        const ReceivingCell &cell = g.cells[id];
+        if (!cell.standable || cell.laneSnapshot == g.snapshot) continue;
+        stale.push_back(id);
+        lanes.add(g.snapBall, Vector(RECEIVE_MARGIN + (id % g.cols) * RECEIVE_STEP,
+                                     RECEIVE_MARGIN + (id / g.cols) * RECEIVE_STEP));
+    }
+    if (stale.empty()) return;
+
+    dist.resize(stale.size());
+    laneDistances(lanes, g.snapOpponents.x.data(), g.snapOpponents.y.data(),
+                  g.snapOpponents.size(), dist.data());
+    for (size_t k = 0; k < stale.size(); ++k) {
+        ReceivingCell &cell = g.cells[stale[k]];
+        cell.laneOppDist = dist[k];
+        cell.laneSnapshot = g.snapshot;
+    }
+}
+
+Vector AIAgent::findOptimalReceivingPoint(const Vector &supportPos,
+                                          const std::vector<Vector> &spacing,
+                                          const Ball &ball,
+                                          const Field &field,
+                                          bool isLeftSide,
+                                          const PlayerStore &opponents) {
+    prepareReceivingGrid(field, isLeftSide);
+    float drift = updateLaneSnapshot(ball, opponents);
+    const ReceivingGrid &g = receivingGrid;
 
-            if (totalScore > bestScore) {
-                bestScore = totalScore;
-                bestPos = candidate;
+    float bestScore = -9999.0f;
+    Vector bestPos = supportPos;
+    auto consider = [&](int c, int r, float score) {
+        if (score > bestScore) {
+            bestScore = score;
+            bestPos = Vector(RECEIVE_MARGIN + c * RECEIVE_STEP,
+                             RECEIVE_MARGIN + r * RECEIVE_STEP);
+        }
+    };
+
+    // ---- Coarse pass, remembering the best few spots as seeds ----
+    static thread_local std::vector<int> ids;
+    ids.clear();
+    for (int c = 0; c < g.cols; c += COARSE_STRIDE) {
+        for (int r = 0; r < g.rows; r += COARSE_STRIDE) {
+            ids.push_back(r * g.cols + c);
+        }
+    }
+    refreshReceivingLanes(ids);
+
+    int seedCol[REFINE_SEEDS], seedRow[REFINE_SEEDS];
+    float seedScore[REFINE_SEEDS];
+    int seeds = 0;
+    for (int id : ids) {
+        int c = id % g.cols;
+        int r = id / g.cols;
+        float score = scoreReceivingCell(c, r, drift, spacing, ball, field, opponents);
+        consider(c, r, score);
+        if (score <= -1e29f) continue;
+
+        // insertion into the short sorted seed list
+        int k = (seeds < REFINE_SEEDS) ? seeds++ : REFINE_SEEDS;
+        while (k > 0 && seedScore[k - 1] < score) {
+            if (k < REFINE_SEEDS) {
+                seedCol[k] = seedCol[k - 1];
+                seedRow[k] = seedRow[k - 1];
+                seedScore[k] = seedScore[k - 1];
+            }
+            k--;
+        }
+        if (k < REFINE_SEEDS) {
+            seedCol[k] = c;
+            seedRow[k] = r;
+            seedScore[k] = score;
+        }
+    }
+
+    // ---- Fine pass around each seed, half a coarse cell each way ----
+    const int reach = COARSE_STRIDE / 2;
+    ids.clear();
+    for (int s = 0; s < seeds; ++s) {
+        int c0 = std::max(0, seedCol[s] - reach), c1 = std::min(g.cols - 1, seedCol[s] + reach);
+        int r0 = std::max(0, seedRow[s] - reach), r1 = std::min(g.rows - 1, seedRow[s] + reach);
+        for (int c = c0; c <= c1; ++c) {
+            for (int r = r0; r <= r1; ++r) {
+                if (c % COARSE_STRIDE == 0 && r % COARSE_STRIDE == 0) continue;  // done
+                ids.push_back(r * g.cols + c);
             }
         }
     }
+    refreshReceivingLanes(ids);
+    for (int id : ids) {
+        int c = id % g.cols;
+        int r = id / g.cols;
+        consider(c, r, scoreReceivingCell(c, r, drift, spacing, ball, field, opponents));
+    }
 
     return bestPos;
 }
@@ -446,12 +867,15 @@ Vector AIAgent::findOptimalReceivingPoint(const Player &support,
 // ============================================================================
 // Legacy single-player update (backward compatibility)
 // ============================================================================
-void AIAgent::update(float dt, Player &aiPlayer, const Ball &ball,
+void AIAgent::update(float dt, Team &team, int index, const Ball &ball,
                      const Field &field, bool isLeftSide) {
+    PlayerStore &players = team.players;
+    Vector pos = players.getPos(index);
+
     float homeX = isLeftSide ? field.getWidth() * 0.25f : field.getWidth() * 0.75f;
     float homeY = field.getHeight() / 2.0f;
 
-    Vector toBall = ball.pos - aiPlayer.pos;
+    Vector toBall = ball.pos - pos;
     float distToBall = toBall.length();
 
     bool ballOnOurSide = isLeftSide ? (ball.pos.x < field.getWidth() / 2.0f)
@@ -464,15 +888,23 @@ void AIAgent::update(float dt, Player &aiPlayer, const Ball &ball,
         } else {
             target = Vector(ball.pos.x + 1.5f, ball.pos.y);
         }
-        bool behindBall = isLeftSide ? (aiPlayer.pos.x < ball.pos.x - 0.5f)
-                                      : (aiPlayer.pos.x > ball.pos.x + 0.5f);
+        bool behindBall = isLeftSide ? (pos.x < ball.pos.x - 0.5f)
+                                      : (pos.x > ball.pos.x + 0.5f);
         if (behindBall || distToBall < 2.0f) {
             target = ball.pos;
         }
+    } else if (influence.isBuilt()) {
+        // Hold the defensive spot, clear of the teammates
+        static thread_local std::vector<Vector> mates;
+        mates.clear();
+        for (int i = 0; i < players.size(); ++i) {
+            if (i != index) mates.push_back(players.getPos(i));
+        }
+        target = influence.defendSpot(ball.pos, pos, mates);
     } else {
         target = Vector(homeX, ball.pos.y * 0.5f + homeY * 0.5f);
     }
 
-    seekWithArrival(dt, aiPlayer, target, 2.0f);
-    clampToField(aiPlayer, field);
+    seekWithArrival(dt, players, index, target, field, 2.0f);
+    clampToField(players, index, field);
 }
@@ -0,0 +1,167 @@
+#include "../include/AssetManager.h"
+#include <SDL_image.h>
+#include <iostream>
+
+AssetManager::AssetManager()
+: renderer(nullptr), stopping(false), requested(0), finished(0) {}
+
+AssetManager::~AssetManager() {
+    stop();
+}
+
+void AssetManager::start(SDL_Renderer *target) {
+    if (worker.joinable()) return;
+    renderer = target;
+    stopping = false;
+    worker = std::thread([this]() { run(); });
+}
+
+void AssetManager::stop() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            fontJobs.clear();
+            bulkJobs.clear();
+        }
+        wake.notify_all();
+        worker.join();
+    }
+    ready.clear();
+    for (auto &entry : fonts) entry.second->release();
+    fonts.clear();
+    sprites.release();
+    renderer = nullptr;
+    requested = finished = 0;
+}
+
+// ============================================================================
+// Loader thread
+// ============================================================================
+void AssetManager::run() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() {
+                return stopping || !fontJobs.empty() || !bulkJobs.empty();
+            });
+            if (stopping) return;
+            std::deque<std::function<void()>> &jobs = fontJobs.empty() ? bulkJobs : fontJobs;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void AssetManager::post(std::function<void()> job, bool font) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        (font ? fontJobs : bulkJobs).push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+std::shared_ptr<FontAtlas> AssetManager::font(const std::string &path, int pointSize) {
+    if (!worker.joinable()) return nullptr;
+    std::shared_ptr<FontAtlas> &handle = fonts[std::make_pair(path, pointSize)];
+    if (handle) return handle;
+
+    handle = std::make_shared<FontAtlas>();
+    requested++;
+    std::shared_ptr<FontAtlas> target = handle;
+    post([this, target, path, pointSize]() {
+        std::unique_ptr<FontAtlas> staged(new FontAtlas());
+        if (!staged->rasterize(path, pointSize)) staged.reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(Staged{target, std::move(staged), nullptr});
+    }, true);
+    return handle;
+}
+
+void AssetManager::loadSprites(const std::vector<SpriteFile> &files) {
+    if (!worker.joinable()) return;
+    requested++;
+    post([this, files]() {
+        std::unique_ptr<SpriteAtlas> staged(new SpriteAtlas());
+        for (const SpriteFile &file : files) {
+            SDL_Surface *surface = IMG_Load(file.path.c_str());
+            if (!surface) {
+                std::cerr << "Failed to load sprite " << file.path << ": " << IMG_GetError()
+                          << std::endl;
+                continue;
+            }
+            staged->addImage(file.id, surface, file.maxSize);
+            SDL_FreeSurface(surface);
+        }
+        staged->addShapes();
+        staged->pack();
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(Staged{nullptr, nullptr, std::move(staged)});
+    }, false);
+}
+
+// ============================================================================
+// Render thread
+// ============================================================================
+bool AssetManager::uploadSlice(Staged &staged) {
+    if (staged.font) {
+        if (!staged.font->upload(renderer, ROWS_PER_SLICE)) {
+            staged.font.reset();
+            return true;
+        }
+        return staged.font->getPendingRows() == 0;
+    }
+    if (staged.sprites) {
+        if (!staged.sprites->upload(renderer, ROWS_PER_SLICE)) {
+            staged.sprites.reset();
+            return true;
+        }
+        return staged.sprites->getPendingRows() == 0;
+    }
+    return true;   // decoding failed; nothing to upload
+}
+
+void AssetManager::publish(Staged &staged) {
+    // A failed font leaves its handle empty: it keeps drawing nothing
+    if (staged.target && staged.font) staged.target->swap(*staged.font);
+    if (staged.sprites) sprites.swap(*staged.sprites);
+}
+
+void AssetManager::update(double budgetMs) {
+    if (!renderer) return;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 budget = (Uint64)(budgetMs * SDL_GetPerformanceFrequency() / 1000.0);
+    for (;;) {
+        Staged *staged;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ready.empty()) return;
+            // The loader only appends, so the front stays put
+            staged = &ready.front();
+        }
+        if (uploadSlice(*staged)) {
+            publish(*staged);
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.pop_front();
+            finished++;
+        }
+        if (SDL_GetPerformanceCounter() - start >= budget) return;
+    }
+}
+
+float AssetManager::getProgress() const {
+    return requested > 0 ? (float)finished / requested : 1.0f;
+}
+
+void AssetManager::purgeUnused() {
+    for (auto it = fonts.begin(); it != fonts.end();) {
+        // A font still loading is also held by its job
+        if (it->second.use_count() == 1) {
+            it = fonts.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
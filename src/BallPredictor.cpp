@@ -0,0 +1,163 @@
+#include "../include/BallPredictor.h"
+#include "../include/Ball.h"
+#include "../include/Collision.h"
+#include "../include/Field.h"
+#include <algorithm>
+#include <cmath>
+
+// As in Ball::applyFriction and Field::moveBall
+static const float STOP_SPEED = 0.1f;     // m/s; slower balls are stopped
+static const float CONTACT_SKIN = 1e-4f;
+
+// intercept() stops refining within this many metres of the ball
+static const float INTERCEPT_TOLERANCE = 0.02f;
+static const int   INTERCEPT_MAX_STEPS = 32;
+
+// ============================================================================
+// Closed form
+// ============================================================================
+float BallPredictor::distanceAfter(const Segment &s, float tau) const {
+    // v0 dt (1 + k + ... + k^(n-1)) for n = tau / dt steps
+    float n = tau / stepDt;
+    return s.v0 * stepDt * -std::expm1(logK * n) / -std::expm1(logK);
+}
+
+float BallPredictor::timeToTravel(float v0, float dist) const {
+    float frac = dist * -std::expm1(logK) / (v0 * stepDt);
+    if (frac >= 1.0f) return -1.0f;
+    return std::log1p(-frac) / logK * stepDt;
+}
+
+// ============================================================================
+// Tracing the path
+// ============================================================================
+void BallPredictor::predict(const Ball &ball, const Field &field, float dt) {
+    segments.clear();
+    goal = 0;
+    stepDt = dt;
+    logK = std::log(ball.friction * 0.95f) * dt * 60.0f;
+    if (!(logK < 0.0f)) logK = -1e-6f;  // frictionless: still stops, eventually
+
+    const float r = ball.radius;
+    const float width = field.getWidth();
+    const float goalTop = field.getGoalTop();
+    const float goalBot = field.getGoalBottom();
+    float walls[Field::WALL_BOXES][4];
+    field.wallBoxes(walls);
+
+    Vector p = ball.pos;
+    Vector v = ball.vel;
+    float t = 0.0f;
+    for (int bounce = 0; bounce <= MAX_BOUNCES; ++bounce) {
+        Segment seg{t, t, p, Vector(1.0f, 0.0f), v.length(), 0.0f};
+        if (seg.v0 < STOP_SPEED) {
+            // At rest (or as good as): a segment of no length holds it here
+            seg.v0 = 0.0f;
+            segments.push_back(seg);
+            break;
+        }
+        seg.dir = v / seg.v0;
+
+        // Whole steps until the speed drops below STOP_SPEED, and how far
+        // the ball gets on them
+        float steps = std::max(1.0f, std::ceil(std::log(STOP_SPEED / seg.v0) / logK));
+        float tStop = steps * stepDt;
+        float length = distanceAfter(seg, tStop);
+        Vector move = seg.dir * length;
+
+        SweepHit best{2.0f, Vector()};
+        SweepHit hit;
+        for (const auto &w : walls) {
+            if (sweepCircleVsAABB(p, move, r, w[0], w[1], w[2], w[3], hit) && hit.t < best.t) {
+                best = hit;
+            }
+        }
+        if (field.sweepObstacles(p, move, r, hit) && hit.t < best.t) {
+            best = hit;
+        }
+
+        // Into a goal: the centre one radius behind the line, in the mouth
+        float goalX[2] = {-r, width + r};
+        for (int side = 0; side < 2 && !goal; ++side) {
+            float before = p.x - goalX[side];
+            float after = p.x + move.x - goalX[side];
+            bool crosses = (side == 0) ? (before >= 0.0f && after < 0.0f)
+                                       : (before <= 0.0f && after > 0.0f);
+            if (!crosses) continue;
+            float f = before / (before - after);
+            float y = p.y + move.y * f;
+            if (f <= best.t && y >= goalTop && y <= goalBot) {
+                goal = side + 1;
+                best.t = f;
+            }
+        }
+
+        if (best.t > 1.0f) {
+            seg.length = length;
+            seg.tEnd = t + tStop;
+            segments.push_back(seg);
+            break;
+        }
+
+        seg.length = length * best.t;
+        float tau = timeToTravel(seg.v0, seg.length);
+        if (tau < 0.0f) tau = tStop;
+        seg.tEnd = t + tau;
+        segments.push_back(seg);
+        if (goal) break;
+
+        // Bounce off the surface with the speed left at the contact
+        p = p + move * best.t + best.normal * CONTACT_SKIN;
+        v = seg.dir * (seg.v0 * std::exp(logK * tau / stepDt));
+        float vdot = v.dot(best.normal);
+        if (vdot < 0.0f) v -= best.normal * ((1.0f + Field::WALL_RESTITUTION) * vdot);
+        t += tau;
+    }
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+const BallPredictor::Segment &BallPredictor::segmentAt(float t) const {
+    for (const Segment &s : segments) {
+        if (t <= s.tEnd) return s;
+    }
+    return segments.back();
+}
+
+Vector BallPredictor::positionAt(float t) const {
+    if (segments.empty()) return Vector();
+    const Segment &s = segmentAt(t);
+    float tau = std::min(std::max(t - s.t0, 0.0f), s.tEnd - s.t0);
+    return s.p0 + s.dir * std::min(distanceAfter(s, tau), s.length);
+}
+
+float BallPredictor::speedAt(float t) const {
+    if (segments.empty() || t >= getEndTime()) return 0.0f;
+    const Segment &s = segmentAt(t);
+    float tau = std::max(t - s.t0, 0.0f);
+    return s.v0 * std::exp(logK * tau / stepDt);
+}
+
+bool BallPredictor::intercept(const Vector &from, float speed, float reach,
+                              float &time, Vector &point) const {
+    if (segments.empty()) return false;
+    // Conservative advancement: the gap between the player's reach and
+    // the ball can close no faster than their two speeds together (the
+    // ball only ever slows down), so stepping by gap / closing speed
+    // never skips past the first time it closes.
+    float t = 0.0f;
+    for (int step = 0; step < INTERCEPT_MAX_STEPS; ++step) {
+        if (goal && t > getEndTime()) return false;
+        Vector b = positionAt(t);
+        float gap = (b - from).length() - reach - speed * t;
+        if (gap <= INTERCEPT_TOLERANCE) break;
+        float closing = speedAt(t) + speed;
+        if (closing <= 0.0f) return false;
+        t += gap / closing;
+    }
+    if (goal && t > getEndTime()) return false;
+    time = t;
+    point = positionAt(t);
+    return true;
+}
@@ -0,0 +1,110 @@
+#include "../include/Camera.h"
+#include "../include/Field.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CAMERA_SSE2 1
+#include <emmintrin.h>
+#endif
+
+Camera::Camera()
+: mode(CameraMode::FIXED), zoom(1.0f), centre(), centred(false),
+  screenW(0), screenH(0), scaleX(1.0f), scaleY(1.0f), offsetX(0.0f), offsetY(0.0f),
+  pitch{0.0f, 0.0f, 0.0f, 0.0f}, fieldSize() {}
+
+Camera Camera::fitTo(const Field &field, const SDL_FRect &rect) {
+    Camera c;
+    c.fieldSize = Vector(field.getWidth(), field.getHeight());
+    c.centre = c.fieldSize / 2.0f;
+    c.centred = true;
+    c.screenW = (int)rect.w;
+    c.screenH = (int)rect.h;
+    c.scaleX = rect.w / field.getWidth();
+    c.scaleY = rect.h / field.getHeight();
+    c.offsetX = rect.x;
+    c.offsetY = rect.y;
+    c.pitch = rect;
+    return c;
+}
+
+void Camera::frame(const Field &field, int w, int h) {
+    screenW = w;
+    screenH = h;
+    fieldSize = Vector(field.getWidth(), field.getHeight());
+    if (!centred) {
+        centre = fieldSize / 2.0f;
+        centred = true;
+    }
+    clampCentre();
+
+    // The whole pitch at zoom 1: 95% of the width, 2:1, bottom of the window
+    int fieldW = (int)(w * 0.95f);
+    int fieldH = fieldW / 2;
+    int fieldX = (w - fieldW) / 2;
+    int fieldY = h - fieldH;
+
+    float baseX = (float)fieldW / fieldSize.x;
+    float baseY = (float)fieldH / fieldSize.y;
+    scaleX = baseX * zoom;
+    scaleY = baseY * zoom;
+    if (zoom == MIN_ZOOM) {
+        // exactly the old fitted viewport (the centre is clamped to the
+        // pitch centre at this zoom)
+        offsetX = (float)fieldX;
+        offsetY = (float)fieldY;
+    } else {
+        offsetX = fieldX + fieldW / 2.0f - centre.x * scaleX;
+        offsetY = fieldY + fieldH / 2.0f - centre.y * scaleY;
+    }
+    pitch = SDL_FRect{offsetX, offsetY, fieldSize.x * scaleX, fieldSize.y * scaleY};
+}
+
+void Camera::follow(const Vector &target, float dt) {
+    if (mode != CameraMode::FOLLOW_BALL || !centred) return;
+    float k = 1.0f - std::exp(-dt / FOLLOW_TIME);
+    centre += (target - centre) * k;
+    clampCentre();
+}
+
+void Camera::setZoom(float z) {
+    zoom = std::max(MIN_ZOOM, std::min(MAX_ZOOM, z));
+    clampCentre();
+}
+
+void Camera::pan(const Vector &delta) {
+    centre += delta;
+    clampCentre();
+}
+
+void Camera::reset() {
+    mode = CameraMode::FIXED;
+    zoom = 1.0f;
+    centred = false;
+}
+
+void Camera::clampCentre() {
+    if (!centred) return;
+    // Half the pitch is visible on each side of the centre at zoom 1
+    float halfW = fieldSize.x / (2.0f * zoom);
+    float halfH = fieldSize.y / (2.0f * zoom);
+    centre.x = std::max(halfW, std::min(fieldSize.x - halfW, centre.x));
+    centre.y = std::max(halfH, std::min(fieldSize.y - halfH, centre.y));
+}
+
+void Camera::transform(const float *x, const float *y, int n,
+                       float *outX, float *outY) const {
+    int i = 0;
+#ifdef CAMERA_SSE2
+    const __m128 sx = _mm_set1_ps(scaleX), sy = _mm_set1_ps(scaleY);
+    const __m128 ox = _mm_set1_ps(offsetX), oy = _mm_set1_ps(offsetY);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(outX + i, _mm_add_ps(ox, _mm_mul_ps(_mm_loadu_ps(x + i), sx)));
+        _mm_storeu_ps(outY + i, _mm_add_ps(oy, _mm_mul_ps(_mm_loadu_ps(y + i), sy)));
+    }
+#endif
+    for (; i < n; ++i) {
+        outX[i] = offsetX + x[i] * scaleX;
+        outY[i] = offsetY + y[i] * scaleY;
+    }
+}
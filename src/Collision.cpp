@@ -0,0 +1,110 @@
+#include "../include/Collision.h"
+#include <algorithm>
+#include <cmath>
+
+bool sweepCircleVsCircle(const Vector &start, const Vector &move, float radius,
+                         const Vector &centre, float otherRadius,
+                         SweepHit &hit) {
+    // Ray start + move*t against a circle of the combined radius
+    float R = radius + otherRadius;
+    Vector m = start - centre;
+    float b = m.dot(move);
+    float c = m.dot(m) - R * R;
+
+    // Moving away (or parallel) from the circle: no new contact
+    if (b >= 0.0f) return false;
+
+    if (c <= 0.0f) {
+        // Already touching and moving further in
+        float len = m.length();
+        hit.t = 0.0f;
+        hit.normal = (len > 1e-6f) ? m / len : (move * -1.0f).normalized();
+        return true;
+    }
+
+    float a = move.dot(move);
+    float disc = b * b - a * c;
+    if (a <= 0.0f || disc < 0.0f) return false;
+
+    float t = (-b - std::sqrt(disc)) / a;
+    if (t > 1.0f) return false;
+    if (t < 0.0f) t = 0.0f;
+
+    hit.t = t;
+    hit.normal = ((start + move * t) - centre).normalized();
+    return true;
+}
+
+bool sweepCircleVsAABB(const Vector &start, const Vector &move, float radius,
+                       float minX, float minY, float maxX, float maxY,
+                       SweepHit &hit) {
+    // ---- Already overlapping: resolve at t = 0 if heading further in ----
+    float cx = std::min(std::max(start.x, minX), maxX);
+    float cy = std::min(std::max(start.y, minY), maxY);
+    Vector toStart(start.x - cx, start.y - cy);
+    float d2 = toStart.dot(toStart);
+    if (d2 < radius * radius) {
+        Vector n;
+        if (d2 > 1e-12f) {
+            n = toStart / std::sqrt(d2);
+        } else {
+            // Centre inside the box: leave through the nearest face
+            float dl = start.x - minX, dr = maxX - start.x;
+            float dt = start.y - minY, db = maxY - start.y;
+            float best = std::min(std::min(dl, dr), std::min(dt, db));
+            if (best == dl)      n = Vector(-1, 0);
+            else if (best == dr) n = Vector(1, 0);
+            else if (best == dt) n = Vector(0, -1);
+            else                 n = Vector(0, 1);
+        }
+        if (move.dot(n) >= 0.0f) return false;
+        hit.t = 0.0f;
+        hit.normal = n;
+        return true;
+    }
+
+    // ---- Ray against the box grown by the radius (slab test) ----
+    float lo[2] = {minX - radius, minY - radius};
+    float hi[2] = {maxX + radius, maxY + radius};
+    float p[2]  = {start.x, start.y};
+    float d[2]  = {move.x, move.y};
+
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    int enterAxis = -1;
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::abs(d[axis]) < 1e-12f) {
+            if (p[axis] < lo[axis] || p[axis] > hi[axis]) return false;
+            continue;
+        }
+        float inv = 1.0f / d[axis];
+        float t1 = (lo[axis] - p[axis]) * inv;
+        float t2 = (hi[axis] - p[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        if (t1 > tEnter) {
+            tEnter = t1;
+            enterAxis = axis;
+        }
+        tExit = std::min(tExit, t2);
+        if (tEnter > tExit) return false;
+    }
+
+    // Where the ray enters the grown box.  Inside the corner squares the
+    // real shape is rounded, so test against the corner circle instead.
+    Vector q = start + move * tEnter;
+    bool outX = (q.x < minX || q.x > maxX);
+    bool outY = (q.y < minY || q.y > maxY);
+    if (outX && outY) {
+        Vector corner(q.x < minX ? minX : maxX, q.y < minY ? minY : maxY);
+        return sweepCircleVsCircle(start, move, radius, corner, 0.0f, hit);
+    }
+
+    // enterAxis < 0 means the start is inside the grown box but outside the
+    // rounded shape, which only happens in a corner square (handled above)
+    if (enterAxis < 0) return false;
+
+    hit.t = tEnter;
+    hit.normal = (enterAxis == 0) ? Vector(d[0] > 0.0f ? -1.0f : 1.0f, 0.0f)
+                                  : Vector(0.0f, d[1] > 0.0f ? -1.0f : 1.0f);
+    return true;
+}
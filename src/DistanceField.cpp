@@ -0,0 +1,87 @@
+#include "../include/DistanceField.h"
+#include "../include/Obstacle.h"
+#include <algorithm>
+#include <cmath>
+
+DistanceField::DistanceField(float minX, float minY, float maxX, float maxY,
+                             float cellSize, float maxDistance)
+    : minX(minX),
+      minY(minY),
+      cellSize(cellSize),
+      invCellSize(1.0f / cellSize),
+      maxDistance(maxDistance),
+      cols((int)std::ceil((maxX - minX) / cellSize) + 1),
+      rows((int)std::ceil((maxY - minY) / cellSize) + 1),
+      dist(cols * rows, maxDistance),
+      gradX(cols * rows, 0.0f),
+      gradY(cols * rows, 0.0f) {}
+
+void DistanceField::addObstacle(const Obstacle &obs) {
+    // Only nodes within maxDistance of the bounding box can get closer
+    float reach = maxDistance + cellSize;
+    float x0 = obs.getPos().x - obs.getWidth() / 2.0f - reach;
+    float x1 = obs.getPos().x + obs.getWidth() / 2.0f + reach;
+    float y0 = obs.getPos().y - obs.getHeight() / 2.0f - reach;
+    float y1 = obs.getPos().y + obs.getHeight() / 2.0f + reach;
+    int i0 = std::max(0, (int)std::floor((x0 - minX) * invCellSize));
+    int i1 = std::min(cols - 1, (int)std::ceil((x1 - minX) * invCellSize));
+    int j0 = std::max(0, (int)std::floor((y0 - minY) * invCellSize));
+    int j1 = std::min(rows - 1, (int)std::ceil((y1 - minY) * invCellSize));
+
+    // Gradient by central differences of the exact distance
+    const float h = cellSize * 0.01f;
+    for (int j = j0; j <= j1; ++j) {
+        for (int i = i0; i <= i1; ++i) {
+            Vector p(minX + i * cellSize, minY + j * cellSize);
+            float d = std::min(obs.signedDistance(p), maxDistance);
+            int k = j * cols + i;
+            if (d >= dist[k]) continue;
+
+            dist[k] = d;
+            float gx = obs.signedDistance(Vector(p.x + h, p.y)) -
+                       obs.signedDistance(Vector(p.x - h, p.y));
+            float gy = obs.signedDistance(Vector(p.x, p.y + h)) -
+                       obs.signedDistance(Vector(p.x, p.y - h));
+            float len = std::sqrt(gx * gx + gy * gy);
+            gradX[k] = len > 0.0f ? gx / len : 0.0f;
+            gradY[k] = len > 0.0f ? gy / len : 0.0f;
+        }
+    }
+}
+
+void DistanceField::locate(const Vector &p, int &i, int &j, float &fx, float &fy) const {
+    float gx = (p.x - minX) * invCellSize;
+    float gy = (p.y - minY) * invCellSize;
+    gx = std::min(std::max(gx, 0.0f), (float)(cols - 1));
+    gy = std::min(std::max(gy, 0.0f), (float)(rows - 1));
+    i = std::min((int)gx, cols - 2);
+    j = std::min((int)gy, rows - 2);
+    fx = gx - i;
+    fy = gy - j;
+}
+
+float DistanceField::distance(const Vector &p) const {
+    int i, j;
+    float fx, fy;
+    locate(p, i, j, fx, fy);
+    int k = j * cols + i;
+    float top = dist[k] + (dist[k + 1] - dist[k]) * fx;
+    float bot = dist[k + cols] + (dist[k + cols + 1] - dist[k + cols]) * fx;
+    float d = top + (bot - top) * fy;
+
+    // Outside the baked area: add how far p is from the point sampled
+    Vector sampled(minX + (i + fx) * cellSize, minY + (j + fy) * cellSize);
+    return d + (p - sampled).length();
+}
+
+Vector DistanceField::gradient(const Vector &p) const {
+    int i, j;
+    float fx, fy;
+    locate(p, i, j, fx, fy);
+    int k = j * cols + i;
+    float w00 = (1 - fx) * (1 - fy), w10 = fx * (1 - fy);
+    float w01 = (1 - fx) * fy,       w11 = fx * fy;
+    Vector g(gradX[k] * w00 + gradX[k + 1] * w10 + gradX[k + cols] * w01 + gradX[k + cols + 1] * w11,
+             gradY[k] * w00 + gradY[k + 1] * w10 + gradY[k + cols] * w01 + gradY[k + cols + 1] * w11);
+    return g.normalized();
+}
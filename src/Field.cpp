@@ -1,34 +1,22 @@
 #include "../include/Field.h"
 #include "../include/Obstacle.h"
 #include "../include/Ball.h"
+#include "../include/PlayerStore.h"
+#include "../include/Collision.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 
-Field::Field(float width_m, float height_m)
-    : width(width_m), height(height_m), goalHeight(6.0f), goalDepth(2.0f) {}
-
-SDL_FPoint Field::worldToScreen(float worldX, float worldY,
-                                int screenW, int screenH) const {
-    // compute the same viewport used by render()
-    int fieldW = (int)(screenW * 0.95f);
-    int fieldH = fieldW / 2;
-    int fieldX = (screenW - fieldW) / 2;
-    int fieldY = screenH - fieldH;
+// Source of Field revisions; every layout gets a number of its own
+static std::atomic<uint32_t> nextRevision(1);
 
-    float sx = (float)fieldW / width;
-    float sy = (float)fieldH / height;
-
-    return SDL_FPoint{ fieldX + worldX * sx,
-                       fieldY + worldY * sy };
-}
-
-SDL_Rect Field::getViewport(int screenW, int screenH) const {
-    int fieldW = (int)(screenW * 0.95f);
-    int fieldH = fieldW / 2;
-    int fieldX = (screenW - fieldW) / 2;
-    int fieldY = screenH - fieldH;
-    return SDL_Rect{ fieldX, fieldY, fieldW, fieldH };
-}
+Field::Field(float width_m, float height_m)
+    : width(width_m), height(height_m), goalHeight(6.0f), goalDepth(2.0f),
+      // bake a margin around the pitch so balls inside the goals are covered
+      sdf(std::make_shared<DistanceField>(-goalDepth - 1.0f, -1.0f,
+                                          width_m + goalDepth + 1.0f, height_m + 1.0f)),
+      revision(nextRevision++) {}
 
 // ---------------------------------------------------------------------------
 // obstacle & player helper implementations
@@ -36,94 +24,96 @@ SDL_Rect Field::getViewport(int screenW, int screenH) const {
 
 void Field::addObstacle(const Obstacle &obs) {
     obstacles.push_back(obs);
+    if (sdf.use_count() > 1) {
+        sdf = std::make_shared<DistanceField>(*sdf);
+    }
+    sdf->addObstacle(obs);
+    revision = nextRevision++;
 }
 
-void Field::handlePlayerCollision(Player &player) const {
-    for (const Obstacle &obs : obstacles) {
-        obs.resolvePlayerCollision(player);
-    }
+// Angle between the lines from p to the two posts:
+//
+//   θ = atan2(dy_top, dx) - atan2(dy_bot, dx)
+//
+// folded into [0, π].
+float Field::goalAngle(const Vector &p, float goalX) const {
+    float angleTop = std::atan2(getGoalTop() - p.y, goalX - p.x);
+    float angleBot = std::atan2(getGoalBottom() - p.y, goalX - p.x);
+    float angle = std::abs(angleTop - angleBot);
+    if (angle > 3.14159f) angle = 2.0f * 3.14159f - angle;
+    return angle;
+}
+
+// Direction to push something overlapping an obstacle at p.  On the medial
+// axis of an obstacle (e.g. its exact centre) the gradient cancels out, so
+// fall back to pushing downwards.
+static Vector pushDirection(const DistanceField &sdf, const Vector &p) {
+    Vector n = sdf.gradient(p);
+    if (n.x == 0.0f && n.y == 0.0f) return Vector(0.0f, 1.0f);
+    return n;
 }
 
-void Field::render(SDL_Renderer* renderer, int screenW, int screenH,
-                      SDL_Texture *texture) const {
-    int fieldW = (int)(screenW * 0.95f);
-    int fieldH = fieldW / 2;
-    SDL_Rect bg{(screenW - fieldW) / 2, screenH - fieldH, fieldW, fieldH};
-    if (texture) {
-        SDL_RenderCopy(renderer, texture, nullptr, &bg);
-    } else {
-        // field background - dark green
-        SDL_SetRenderDrawColor(renderer, 30, 120, 60, 255);
-        SDL_RenderFillRect(renderer, &bg);
+void Field::handlePlayerCollisions(PlayerStore &players) const {
+    for (int i = 0; i < players.size(); ++i) {
+        Vector p = players.getPos(i);
+        float d = sdf->distance(p);
+        if (d < players.radius[i]) {
+            // push out along the distance gradient by the overlap
+            players.translate(i, pushDirection(*sdf, p) * (players.radius[i] - d));
+        }
     }
+}
 
-    // scaling factors for world coordinates -> field viewport
-    float sx = (float)fieldW / width;
-    float sy = (float)fieldH / height;
+// Sphere tracing: the distance field says how far the circle can move
+// before it could possibly touch anything, so step by that much until it
+// is in contact or the move is used up.
+static const float TRACE_CONTACT = 0.005f;  // metres; counts as touching
+static const float TRACE_MIN_STEP = 0.01f;  // metres; bounds the step count
+static const int   TRACE_MAX_STEPS = 64;
 
-    // helper lambda to transform an x/y pair
-    auto toScreen = [&](float wx, float wy) {
-        SDL_FPoint p = worldToScreen(wx, wy, screenW, screenH);
-        return p;
-    };
+bool Field::sweepObstacles(const Vector &start, const Vector &move, float r,
+                           SweepHit &hit) const {
+    float len = move.length();
+    if (len <= 0.0f) return false;
+    Vector dir = move / len;
 
-    // Draw center line (in world coords x = width/2 from y=0..height)
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
-    SDL_FPoint p1 = toScreen(width / 2.0f, 0.0f);
-    SDL_FPoint p2 = toScreen(width / 2.0f, height);
-    SDL_RenderDrawLine(renderer, (int)p1.x, (int)p1.y, (int)p2.x, (int)p2.y);
-
-    // Draw center circle
-    int circleR = (int)(3.0f * std::min(sx, sy));
-    SDL_FPoint center = toScreen(width / 2.0f, height / 2.0f);
-    for (int dy = -circleR; dy <= circleR; ++dy) {
-        int dx = (int)std::sqrt((float)(circleR * circleR - dy * dy));
-        SDL_RenderDrawPoint(renderer, (int)center.x - dx, (int)center.y + dy);
-        SDL_RenderDrawPoint(renderer, (int)center.x + dx, (int)center.y + dy);
+    float t = 0.0f;
+    for (int step = 0; step < TRACE_MAX_STEPS && t <= len; ++step) {
+        Vector p = start + dir * t;
+        float gap = sdf->distance(p) - r;
+        if (gap < TRACE_CONTACT) {
+            Vector n = pushDirection(*sdf, p);
+            if (dir.dot(n) < 0.0f) {
+                hit.t = t / len;
+                hit.normal = n;
+                return true;
+            }
+            // touching but already moving away
+            t += TRACE_MIN_STEP;
+        } else {
+            t += std::max(gap, TRACE_MIN_STEP);
+        }
+    }
+    if (t < len) {
+        // Out of steps while creeping along a surface: stop here rather
+        // than risk finishing the move inside it
+        hit.t = t / len;
+        hit.normal = pushDirection(*sdf, start + dir * t);
+        return true;
     }
+    return false;
+}
 
-    // Draw goal zones
-    float goalTopY = getGoalTop();
-    float goalBottomY = getGoalBottom();
-
-    int gt = (int)(goalTopY * sy);
-    int gb = (int)(goalBottomY * sy);
-    int gd = (int)(goalDepth * sx);
-
-    // Left goal (blue tint) - convert to screen coords manually since we have
-    // computed gt/gb/gd in field-relative pixels. fieldX offset must be added.
-    int fieldX = bg.x;
-    SDL_SetRenderDrawColor(renderer, 50, 100, 200, 120);
-    SDL_Rect leftGoal = { fieldX, bg.y + gt, gd, gb - gt };
-    SDL_RenderFillRect(renderer, &leftGoal);
-    SDL_SetRenderDrawColor(renderer, 100, 150, 255, 255);
-    SDL_RenderDrawRect(renderer, &leftGoal);
-
-    // Right goal (red tint)
-    SDL_SetRenderDrawColor(renderer, 200, 50, 50, 120);
-    SDL_Rect rightGoal = { fieldX + fieldW - gd, bg.y + gt, gd, gb - gt };
-    SDL_RenderFillRect(renderer, &rightGoal);
-    SDL_SetRenderDrawColor(renderer, 255, 100, 100, 255);
-    SDL_RenderDrawRect(renderer, &rightGoal);
-
-    // Draw the four barriers as a thin white border around the viewport
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    // Top wall
-    SDL_RenderDrawLine(renderer, fieldX, bg.y, fieldX + fieldW, bg.y);
-    // Bottom wall
-    SDL_RenderDrawLine(renderer, fieldX, bg.y + fieldH - 1,
-                       fieldX + fieldW, bg.y + fieldH - 1);
-    // Left wall (excluding goal opening)
-    SDL_RenderDrawLine(renderer, fieldX, bg.y, fieldX, bg.y + gt);
-    SDL_RenderDrawLine(renderer, fieldX, bg.y + gb, fieldX, bg.y + fieldH);
-    // Right wall (excluding goal opening)
-    SDL_RenderDrawLine(renderer, fieldX + fieldW - 1, bg.y, fieldX + fieldW - 1, bg.y + gt);
-    SDL_RenderDrawLine(renderer, fieldX + fieldW - 1, bg.y + gb,
-                       fieldX + fieldW - 1, bg.y + fieldH);
-
-    // render any obstacles after field elements so they appear on top
-    for (const Obstacle &obs : obstacles) {
-        obs.render(renderer, *this, screenW, screenH);
+bool Field::isPathClear(const Vector &a, const Vector &b, float clearance) const {
+    Vector ab = b - a;
+    float len = ab.length();
+    Vector dir = (len > 0.0f) ? ab / len : Vector(0, 0);
+    float t = 0.0f;
+    while (true) {
+        float gap = sdf->distance(a + dir * std::min(t, len)) - clearance;
+        if (gap < 0.0f) return false;
+        if (t >= len) return true;
+        t += std::max(gap, TRACE_MIN_STEP * 5.0f);
     }
 }
 
@@ -131,7 +121,7 @@ int Field::handleCollision(Ball& ball) const {
     float goalTop = getGoalTop();
     float goalBot = getGoalBottom();
     float r = ball.radius;
-    float e = 0.75f;  // restitution (energy kept per bounce)
+    float e = WALL_RESTITUTION;
 
     // Is ball centre vertically inside the goal opening?
     bool inGoalY = (ball.pos.y >= goalTop && ball.pos.y <= goalBot);
@@ -206,10 +196,119 @@ int Field::handleCollision(Ball& ball) const {
         }
     }
 
-    // finally handle collisions with obstacles
-    for (const Obstacle &obs : obstacles) {
-        obs.handleBallCollision(ball);
+    // finally push the ball out of any obstacle it overlaps
+    float d = sdf->distance(ball.pos);
+    if (d < r) {
+        Vector n = pushDirection(*sdf, ball.pos);
+        ball.pos += n * (r - d);
+        ball.bounce(n, e);
     }
 
     return 0;  // no goal
 }
+
+// ---------------------------------------------------------------------------
+// Swept ball movement
+// ---------------------------------------------------------------------------
+
+// Impacts handled per step before the rest of the step's motion is dropped
+// (a ball wedged between a player and a wall would otherwise loop forever).
+static const int MAX_BALL_BOUNCES = 8;
+
+// Distance the ball is backed off a surface after an impact so the next
+// sweep does not start in contact.
+static const float CONTACT_SKIN = 1e-4f;
+
+void Field::wallBoxes(float boxes[WALL_BOXES][4]) const {
+    const float goalTop = getGoalTop();
+    const float goalBot = getGoalBottom();
+    const float big = width + height;
+    const float walls[WALL_BOXES][4] = {
+        { -big, -big, width + big, 0.0f },               // top
+        { -big, height, width + big, height + big },     // bottom
+        { -big, -big, 0.0f, goalTop },                   // left, above goal
+        { -big, goalBot, 0.0f, height + big },           // left, below goal
+        { width, -big, width + big, goalTop },           // right, above goal
+        { width, goalBot, width + big, height + big },   // right, below goal
+    };
+    std::memcpy(boxes, walls, sizeof(walls));
+}
+
+int Field::moveBall(Ball& ball, float dt, const PlayerStore &team1,
+                    const PlayerStore &team2) const {
+    const float r = ball.radius;
+    const float goalTop = getGoalTop();
+    const float goalBot = getGoalBottom();
+    float walls[WALL_BOXES][4];
+    wallBoxes(walls);
+
+    enum HitKind { HIT_NONE, HIT_SURFACE, HIT_PLAYER };
+
+    float remaining = dt;
+    for (int bounce = 0; bounce < MAX_BALL_BOUNCES && remaining > 0.0f; ++bounce) {
+        Vector move = ball.vel * remaining;
+        if (move.x == 0.0f && move.y == 0.0f) break;
+
+        SweepHit best{2.0f, Vector()};
+        HitKind kind = HIT_NONE;
+        SweepHit hit;
+
+        for (const auto &w : walls) {
+            if (sweepCircleVsAABB(ball.pos, move, r, w[0], w[1], w[2], w[3], hit) &&
+                hit.t < best.t) {
+                best = hit;
+                kind = HIT_SURFACE;
+            }
+        }
+
+        // Obstacles of any shape, through the distance field
+        Vector end = ball.pos + move;
+        if (sweepObstacles(ball.pos, move, r, hit) && hit.t < best.t) {
+            best = hit;
+            kind = HIT_SURFACE;
+        }
+
+        const PlayerStore *teams[2] = {&team1, &team2};
+        for (const PlayerStore *players : teams) {
+            for (int i = 0; i < players->size(); ++i) {
+                if (sweepCircleVsCircle(ball.pos, move, r, players->getPos(i),
+                                        players->radius[i], hit) &&
+                    hit.t < best.t) {
+                    best = hit;
+                    kind = HIT_PLAYER;
+                }
+            }
+        }
+
+        // Goal: the centre crosses one radius behind a goal line (the same
+        // depth handleCollision uses) inside the goal mouth
+        float goalX[2] = {-r, width + r};
+        for (int side = 0; side < 2; ++side) {
+            float before = ball.pos.x - goalX[side];
+            float after = end.x - goalX[side];
+            bool crosses = (side == 0) ? (before >= 0.0f && after < 0.0f)
+                                       : (before <= 0.0f && after > 0.0f);
+            if (!crosses) continue;
+            float t = before / (before - after);
+            float y = ball.pos.y + move.y * t;
+            if (t <= best.t && y >= goalTop && y <= goalBot) {
+                ball.pos = ball.pos + move * t;
+                return side + 1;  // 1 = left goal, 2 = right goal
+            }
+        }
+
+        if (kind == HIT_NONE) {
+            ball.pos = end;
+            break;
+        }
+
+        ball.pos = ball.pos + move * best.t + best.normal * CONTACT_SKIN;
+        remaining *= (1.0f - best.t);
+        if (kind == HIT_PLAYER) {
+            ball.bounceOffPlayer(best.normal);
+        } else {
+            ball.bounce(best.normal, WALL_RESTITUTION);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "../include/FieldLayer.h"
+#include "../include/Camera.h"
+#include "../include/Field.h"
+#include "../include/ShapeBatch.h"
+#include "../include/SpriteAtlas.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Largest layer side in pixels; beyond this (deep zoom on a big window) the
+// layer is stretched rather than drawn bigger.
+static const int MAX_LAYER_SIZE = 4096;
+
+FieldLayer::FieldLayer()
+: renderer(nullptr), layer(nullptr), width(0), height(0), revision(0),
+  background(nullptr), valid(false), unsupported(false) {}
+
+FieldLayer::~FieldLayer() {
+    release();
+}
+
+void FieldLayer::release() {
+    if (layer) SDL_DestroyTexture(layer);
+    layer = nullptr;
+    renderer = nullptr;
+    valid = false;
+    unsupported = false;
+}
+
+// Texture the field background is drawn from (null: plain colour)
+static SDL_Texture *backgroundOf(const SpriteAtlas *sprites) {
+    return sprites && sprites->has(Sprite::FIELD) ? sprites->getTexture() : nullptr;
+}
+
+void FieldLayer::render(ShapeBatch &batch, const Field &field, const Camera &camera,
+                        const SpriteAtlas *sprites) {
+    SDL_Renderer *target = batch.getRenderer();
+    if (target != renderer) release();
+
+    SDL_FRect pitch = camera.getPitchRect();
+    float shrink = std::min(1.0f, MAX_LAYER_SIZE / std::max(pitch.w, pitch.h));
+    int w = std::max(1, (int)std::lround(pitch.w * shrink));
+    int h = std::max(1, (int)std::lround(pitch.h * shrink));
+
+    bool current = valid && layer && width == w && height == h &&
+                   revision == field.getRevision() && background == backgroundOf(sprites);
+    if (!current && !unsupported) {
+        current = rebuild(batch, field, w, h, sprites);
+    }
+    if (!current) {
+        field.render(batch, camera, sprites);
+        return;
+    }
+    batch.sprite(layer, pitch, SDL_Color{255, 255, 255, 255});
+}
+
+bool FieldLayer::rebuild(ShapeBatch &batch, const Field &field, int w, int h,
+                         const SpriteAtlas *sprites) {
+    SDL_Renderer *target = batch.getRenderer();
+    if (!target) return false;
+    // Whatever is queued so far belongs on the screen
+    batch.flush();
+
+    if (!layer || width != w || height != h) {
+        if (layer) SDL_DestroyTexture(layer);
+        layer = SDL_CreateTexture(target, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                  w, h);
+        if (!layer) {
+            std::cerr << "Field layer unavailable, drawing the field every frame: "
+                      << SDL_GetError() << std::endl;
+            unsupported = true;
+            renderer = target;
+            return false;
+        }
+        SDL_SetTextureBlendMode(layer, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture *previous = SDL_GetRenderTarget(target);
+    if (SDL_SetRenderTarget(target, layer) != 0) {
+        SDL_DestroyTexture(layer);
+        layer = nullptr;
+        unsupported = true;
+        renderer = target;
+        return false;
+    }
+    SDL_SetRenderDrawColor(target, 0, 0, 0, 0);
+    SDL_RenderClear(target);
+    field.render(batch, Camera::fitTo(field, SDL_FRect{0.0f, 0.0f, (float)w, (float)h}),
+                 sprites);
+    batch.flush();
+    SDL_SetRenderTarget(target, previous);
+
+    renderer = target;
+    width = w;
+    height = h;
+    revision = field.getRevision();
+    background = backgroundOf(sprites);
+    valid = true;
+    return true;
+}
@@ -0,0 +1,196 @@
+#include "../include/FlowField.h"
+#include "../include/Field.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+// Nodes waypoint() looks ahead along the path
+static const int LOOKAHEAD = 8;
+
+// Straight lines only need this fraction of the radius clear: a player
+// that grazes a corner is pushed off it, and one already touching an
+// obstacle would otherwise have to trace along its surface
+static const float LINE_CLEARANCE = 0.75f;
+
+static const float UNREACHED = 1e30f;
+
+static int nodeCount(float extent) {
+    return (int)std::floor(extent / FlowField::CELL + 1e-3f) + 1;
+}
+
+// ============================================================================
+// Building
+// ============================================================================
+int FlowField::nodeOf(const Field &field, const Vector &p) {
+    int c = (int)std::lround(p.x / CELL);
+    int r = (int)std::lround(p.y / CELL);
+    int cols = nodeCount(field.getWidth());
+    int rows = nodeCount(field.getHeight());
+    c = std::min(std::max(c, 0), cols - 1);
+    r = std::min(std::max(r, 0), rows - 1);
+    return r * cols + c;
+}
+
+bool FlowField::isFor(const Field &field, float r, int targetNode) const {
+    return target == targetNode && radius == r && revision == field.getRevision() &&
+           width == field.getWidth() && height == field.getHeight();
+}
+
+void FlowField::build(const Field &field, float r, int targetNode) {
+    if (radius != r || revision != field.getRevision() || width != field.getWidth() ||
+        height != field.getHeight()) {
+        radius = r;
+        revision = field.getRevision();
+        width = field.getWidth();
+        height = field.getHeight();
+        cols = nodeCount(width);
+        rows = nodeCount(height);
+        blocked.resize(cols * rows);
+        for (int n = 0; n < cols * rows; ++n) {
+            blocked[n] = field.obstacleDistance(nodePos(n)) < radius;
+        }
+    }
+    target = targetNode;
+
+    // Dijkstra over the 8-connected grid
+    static const int DC[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    static const int DR[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+    static const float STEP[8] = {CELL, CELL, CELL, CELL, CELL * 1.41421356f, CELL * 1.41421356f,
+                                  CELL * 1.41421356f, CELL * 1.41421356f};
+
+    // Min-heap of (cost, node) packed into one integer (non-negative
+    // floats order like their bit patterns), on a buffer kept between builds
+    static thread_local std::vector<uint64_t> open;
+    const std::greater<uint64_t> later;
+    auto push = [&](float d, int node) {
+        uint32_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        open.push_back(((uint64_t)bits << 32) | (uint32_t)node);
+        std::push_heap(open.begin(), open.end(), later);
+    };
+    open.clear();
+
+    cost.assign(cols * rows, UNREACHED);
+    cost[target] = 0.0f;
+    push(0.0f, target);
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), later);
+        uint64_t top = open.back();
+        open.pop_back();
+        int n = (int)(uint32_t)top;
+        const float d0 = cost[n];
+        uint32_t bits;
+        std::memcpy(&bits, &d0, sizeof(bits));
+        if ((uint32_t)(top >> 32) > bits) continue;  // superseded entry
+        int c = n % cols;
+        int r = n / cols;
+        for (int k = 0; k < 8; ++k) {
+            int nc = c + DC[k];
+            int nr = r + DR[k];
+            if (nc < 0 || nc >= cols || nr < 0 || nr >= rows) continue;
+            int m = nr * cols + nc;
+            float d = d0 + STEP[k] * (blocked[m] ? BLOCKED_COST : 1.0f);
+            if (d < cost[m]) {
+                cost[m] = d;
+                push(d, m);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+int FlowField::nodeAt(const Vector &p) const {
+    int c = std::min(std::max((int)std::lround(p.x / CELL), 0), cols - 1);
+    int r = std::min(std::max((int)std::lround(p.y / CELL), 0), rows - 1);
+    return r * cols + c;
+}
+
+float FlowField::distance(const Vector &p) const {
+    return cost[nodeAt(p)];
+}
+
+int FlowField::lowestNeighbour(int node) const {
+    int c = node % cols;
+    int r = node / cols;
+    int best = node;
+    for (int dr = -1; dr <= 1; ++dr) {
+        for (int dc = -1; dc <= 1; ++dc) {
+            int nc = c + dc;
+            int nr = r + dr;
+            if (nc < 0 || nc >= cols || nr < 0 || nr >= rows) continue;
+            int m = nr * cols + nc;
+            if (cost[m] < cost[best]) best = m;
+        }
+    }
+    return best;
+}
+
+Vector FlowField::waypoint(const Field &field, const Vector &p) const {
+    int path[LOOKAHEAD];
+    int count = 0;
+    int node = nodeAt(p);
+    while (count < LOOKAHEAD && node != target) {
+        int next = lowestNeighbour(node);
+        if (next == node) break;
+        path[count++] = node = next;
+    }
+    if (count == 0) return nodePos(target);
+    // The furthest node in sight, trying every other one
+    for (int k = count - 1; k > 0; k -= 2) {
+        Vector w = nodePos(path[k]);
+        if (field.isPathClear(p, w, radius * LINE_CLEARANCE)) return w;
+    }
+    return nodePos(path[0]);
+}
+
+// ============================================================================
+// Navigator
+// ============================================================================
+int Navigator::keyNode(const Field &field, const Vector &target, float radius) {
+    // The corners of the lattice cell round the target, nearest first
+    const float spacing = KEY_SPACING * FlowField::CELL;
+    const float x0 = std::floor(target.x / spacing) * spacing;
+    const float y0 = std::floor(target.y / spacing) * spacing;
+    Vector corners[4];
+    for (int k = 0; k < 4; ++k) {
+        corners[k] = Vector(std::min(std::max(x0 + (k & 1) * spacing, 0.0f), field.getWidth()),
+                            std::min(std::max(y0 + (k >> 1) * spacing, 0.0f), field.getHeight()));
+    }
+    std::sort(corners, corners + 4, [&](const Vector &a, const Vector &b) {
+        return (a - target).lengthSquared() < (b - target).lengthSquared();
+    });
+    for (const Vector &corner : corners) {
+        if (field.obstacleDistance(corner) >= radius &&
+            field.isPathClear(corner, target, radius * LINE_CLEARANCE)) {
+            return FlowField::nodeOf(field, corner);
+        }
+    }
+    // Tucked away behind an obstacle: a field of its own
+    return FlowField::nodeOf(field, target);
+}
+
+Vector Navigator::steer(const Field &field, const Vector &from, const Vector &target, float radius) {
+    if (field.isPathClear(from, target, radius * LINE_CLEARANCE)) return target;
+
+    int node = keyNode(field, target, radius);
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot *slot = nullptr;
+    Slot *oldest = &slots[0];
+    for (Slot &s : slots) {
+        if (s.flow.isFor(field, radius, node)) {
+            slot = &s;
+            break;
+        }
+        if (s.lastUsed < oldest->lastUsed) oldest = &s;
+    }
+    if (!slot) {
+        slot = oldest;
+        slot->flow.build(field, radius, node);
+        builds.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot->lastUsed = ++uses;
+    return slot->flow.waypoint(field, from);
+}
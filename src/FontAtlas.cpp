@@ -0,0 +1,243 @@
+#include "../include/FontAtlas.h"
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+// Width of the atlas page; glyphs are packed in rows of one line height.
+static const int PAGE_WIDTH = 512;
+// Empty pixels around each cell so linear filtering never picks up a
+// neighbouring glyph.
+static const int CELL_PADDING = 1;
+
+FontAtlas::FontAtlas()
+: renderer(nullptr), texture(nullptr), page(nullptr), uploadedRows(0),
+  textureW(0), textureH(0), lineHeight(0) {
+    for (Glyph &g : glyphs) g = Glyph{{0, 0, 0, 0}, 0, 0};
+}
+
+FontAtlas::~FontAtlas() {
+    release();
+}
+
+void FontAtlas::release() {
+    if (texture) SDL_DestroyTexture(texture);
+    if (page) SDL_FreeSurface(page);
+    texture = nullptr;
+    page = nullptr;
+    uploadedRows = 0;
+    renderer = nullptr;
+    kerning.clear();
+    queue.clear();
+}
+
+void FontAtlas::swap(FontAtlas &other) {
+    std::swap(renderer, other.renderer);
+    std::swap(texture, other.texture);
+    std::swap(page, other.page);
+    std::swap(uploadedRows, other.uploadedRows);
+    std::swap(textureW, other.textureW);
+    std::swap(textureH, other.textureH);
+    std::swap(lineHeight, other.lineHeight);
+    std::swap(glyphs, other.glyphs);
+    kerning.swap(other.kerning);
+    queue.swap(other.queue);
+}
+
+bool FontAtlas::load(SDL_Renderer *target, const std::string &path, int pointSize) {
+    return rasterize(path, pointSize) && upload(target, textureH);
+}
+
+bool FontAtlas::rasterize(const std::string &path, int pointSize) {
+    release();
+
+    TTF_Font *font = TTF_OpenFont(path.c_str(), pointSize);
+    if (!font) {
+        std::cerr << "Could not load font " << path << ": " << TTF_GetError() << std::endl;
+        return false;
+    }
+    lineHeight = TTF_FontHeight(font);
+
+    // Each glyph is rendered as a one-character string, so its cell has the
+    // same height and baseline as a whole line rendered by SDL_ttf
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface *cells[CHAR_COUNT] = {};
+    int x = 0, y = 0;
+    int rowH = lineHeight + CELL_PADDING;
+    int pageW = PAGE_WIDTH;
+    for (int i = 0; i < CHAR_COUNT; ++i) {
+        Uint16 ch = (Uint16)(FIRST_CHAR + i);
+        Glyph &g = glyphs[i];
+        g = Glyph{{0, 0, 0, 0}, 0, 0};
+
+        int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) != 0) {
+            continue;
+        }
+        g.advance = advance;
+        g.offsetX = std::min(0, minx);
+        if (ch == ' ') continue;
+
+        char text[2] = {(char)ch, '\0'};
+        cells[i] = TTF_RenderText_Blended(font, text, white);
+        if (!cells[i]) continue;
+
+        int w = cells[i]->w, h = cells[i]->h;
+        pageW = std::max(pageW, w + CELL_PADDING);
+        if (x + w + CELL_PADDING > pageW) {
+            x = 0;
+            y += rowH;
+        }
+        rowH = std::max(rowH, h + CELL_PADDING);
+        g.src = SDL_Rect{x, y, w, h};
+        x += w + CELL_PADDING;
+    }
+
+#ifdef SDL_TTF_VERSION_ATLEAST
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 14)
+    // Pairs the font actually kerns; most are zero
+    kerning.assign(CHAR_COUNT * CHAR_COUNT, 0);
+    bool anyKerning = false;
+    for (int l = 0; l < CHAR_COUNT; ++l) {
+        for (int r = 0; r < CHAR_COUNT; ++r) {
+            int k = TTF_GetFontKerningSizeGlyphs(font, (Uint16)(FIRST_CHAR + l),
+                                                 (Uint16)(FIRST_CHAR + r));
+            k = std::max(-128, std::min(127, k));
+            kerning[l * CHAR_COUNT + r] = (signed char)k;
+            anyKerning = anyKerning || k != 0;
+        }
+    }
+    if (!anyKerning) kerning.clear();
+#endif
+#endif
+    TTF_CloseFont(font);
+
+    // Copy the cells into one page, uploaded by upload()
+    textureW = pageW;
+    textureH = y + rowH;
+    page = SDL_CreateRGBSurfaceWithFormat(0, textureW, textureH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (page) {
+        SDL_FillRect(page, nullptr, SDL_MapRGBA(page->format, 255, 255, 255, 0));
+    }
+    for (int i = 0; i < CHAR_COUNT; ++i) {
+        if (!cells[i]) continue;
+        if (page) {
+            SDL_Rect dst = glyphs[i].src;
+            SDL_SetSurfaceBlendMode(cells[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(cells[i], nullptr, page, &dst);
+        }
+        SDL_FreeSurface(cells[i]);
+    }
+    if (!page) {
+        std::cerr << "Could not create glyph atlas: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool FontAtlas::upload(SDL_Renderer *target, int maxRows) {
+    if (!page) return texture != nullptr;
+    if (!texture) {
+        texture = SDL_CreateTexture(target, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                    textureW, textureH);
+        if (!texture) {
+            std::cerr << "Could not upload glyph atlas: " << SDL_GetError() << std::endl;
+            release();
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        renderer = target;
+    }
+
+    int rows = std::min(std::max(1, maxRows), textureH - uploadedRows);
+    SDL_Rect band = {0, uploadedRows, textureW, rows};
+    if (SDL_MUSTLOCK(page)) SDL_LockSurface(page);
+    int result = SDL_UpdateTexture(texture, &band,
+                                   (const Uint8 *)page->pixels + (size_t)uploadedRows * page->pitch,
+                                   page->pitch);
+    if (SDL_MUSTLOCK(page)) SDL_UnlockSurface(page);
+    if (result != 0) {
+        std::cerr << "Could not upload glyph atlas: " << SDL_GetError() << std::endl;
+        release();
+        return false;
+    }
+    uploadedRows += rows;
+    if (uploadedRows >= textureH) {
+        SDL_FreeSurface(page);
+        page = nullptr;
+    }
+    return true;
+}
+
+const FontAtlas::Glyph *FontAtlas::glyphFor(char c) const {
+    int i = (unsigned char)c - FIRST_CHAR;
+    if (i < 0 || i >= CHAR_COUNT) i = '?' - FIRST_CHAR;
+    return &glyphs[i];
+}
+
+int FontAtlas::kern(char left, char right) const {
+    if (kerning.empty()) return 0;
+    int l = (unsigned char)left - FIRST_CHAR;
+    int r = (unsigned char)right - FIRST_CHAR;
+    if (l < 0 || l >= CHAR_COUNT || r < 0 || r >= CHAR_COUNT) return 0;
+    return kerning[l * CHAR_COUNT + r];
+}
+
+int FontAtlas::measure(const std::string &text) const {
+    int width = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (i > 0) width += kern(text[i - 1], text[i]);
+        width += glyphFor(text[i])->advance;
+    }
+    return width;
+}
+
+void FontAtlas::draw(const std::string &text, int x, int y, SDL_Color color) {
+    if (!isLoaded()) return;
+    int pen = x;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (i > 0) pen += kern(text[i - 1], text[i]);
+        const Glyph *g = glyphFor(text[i]);
+        if (g->src.w > 0) {
+            queue.push_back(Quad{g->src, {pen + g->offsetX, y, g->src.w, g->src.h}, color});
+        }
+        pen += g->advance;
+    }
+}
+
+void FontAtlas::drawCentered(const std::string &text, int cx, int cy, SDL_Color color) {
+    draw(text, cx - measure(text) / 2, cy - lineHeight / 2, color);
+}
+
+void FontAtlas::drawInRect(const std::string &text, const SDL_Rect &rect, SDL_Color color) {
+    draw(text, rect.x + (rect.w - measure(text)) / 2, rect.y + (rect.h - lineHeight) / 2, color);
+}
+
+void FontAtlas::flush() {
+    if (queue.empty()) return;
+    if (!isLoaded()) {
+        queue.clear();
+        return;
+    }
+
+    const float invW = 1.0f / textureW;
+    const float invH = 1.0f / textureH;
+    vertices.clear();
+    indices.clear();
+    for (const Quad &q : queue) {
+        float x0 = (float)q.dst.x, y0 = (float)q.dst.y;
+        float x1 = x0 + q.dst.w, y1 = y0 + q.dst.h;
+        float u0 = q.src.x * invW, v0 = q.src.y * invH;
+        float u1 = (q.src.x + q.src.w) * invW, v1 = (q.src.y + q.src.h) * invH;
+        int base = (int)vertices.size();
+        vertices.push_back(SDL_Vertex{{x0, y0}, q.color, {u0, v0}});
+        vertices.push_back(SDL_Vertex{{x1, y0}, q.color, {u1, v0}});
+        vertices.push_back(SDL_Vertex{{x1, y1}, q.color, {u1, v1}});
+        vertices.push_back(SDL_Vertex{{x0, y1}, q.color, {u0, v1}});
+        const int quadIndices[6] = {0, 1, 2, 0, 2, 3};
+        for (int k : quadIndices) indices.push_back(base + k);
+    }
+    SDL_RenderGeometry(renderer, texture, vertices.data(), (int)vertices.size(),
+                       indices.data(), (int)indices.size());
+    queue.clear();
+}
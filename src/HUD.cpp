@@ -1,23 +1,18 @@
 #include "../include/HUD.h"
+#include "../include/SDLFramework.h"
 #include <cmath>
 #include <sstream>
 #include <iomanip>
 
-HUD::HUD() : font(nullptr), bigFont(nullptr) {}
+HUD::HUD() {}
 
-HUD::~HUD() {
-    if (font) TTF_CloseFont(font);
-    if (bigFont) TTF_CloseFont(bigFont);
-}
+HUD::~HUD() {}
 
-bool HUD::init(const std::string &fontPath, int fontSize) {
-    if (TTF_Init() == -1) {
-        return false;
-    }
-    font = TTF_OpenFont(fontPath.c_str(), fontSize);
+bool HUD::init(SDLFramework &app, const std::string &fontPath, int fontSize) {
+    font = app.getFont(fontPath, fontSize);
     if (!font) return false;
 
-    bigFont = TTF_OpenFont(fontPath.c_str(), fontSize * 2);
+    bigFont = app.getFont(fontPath, fontSize * 2);
     if (!bigFont) {
         bigFont = font; // fallback
     }
@@ -25,30 +20,18 @@ bool HUD::init(const std::string &fontPath, int fontSize) {
     return true;
 }
 
-void HUD::drawText(SDL_Renderer *renderer, const std::string &text,
-                   int x, int y, SDL_Color color, TTF_Font *f, bool centered) const {
-    TTF_Font *useFont = f ? f : font;
+// Queues the text on the font's atlas; render() and renderMessage() flush
+// the atlases once all their text is queued.
+void HUD::drawText(const std::string &text, int x, int y, SDL_Color color,
+                   FontAtlas *f, bool centered) const {
+    FontAtlas *useFont = f ? f : font.get();
     if (!useFont) return;
 
-    SDL_Surface *surf = TTF_RenderText_Blended(useFont, text.c_str(), color);
-    if (!surf) return;
-
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (tex) {
-        SDL_Rect dst;
-        dst.w = surf->w;
-        dst.h = surf->h;
-        if (centered) {
-            dst.x = x - surf->w / 2;
-            dst.y = y - surf->h / 2;
-        } else {
-            dst.x = x;
-            dst.y = y;
-        }
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        SDL_DestroyTexture(tex);
+    if (centered) {
+        useFont->drawCentered(text, x, y, color);
+    } else {
+        useFont->draw(text, x, y, color);
     }
-    SDL_FreeSurface(surf);
 }
 
 void HUD::render(SDL_Renderer *renderer, int screenW, int screenH,
@@ -69,8 +52,8 @@ void HUD::render(SDL_Renderer *renderer, int screenW, int screenH,
     std::string team1Text = std::to_string(score1);
     std::string team2Text = std::to_string(score2);
 
-    drawText(renderer, team1Text, (int)(screenW * .25f), 25, blueColor, bigFont, true);
-    drawText(renderer, team2Text, (int)(screenW * .75f), 25, redColor, bigFont, true );
+    drawText(team1Text, (int)(screenW * .25f), 25, blueColor, bigFont.get(), true);
+    drawText(team2Text, (int)(screenW * .75f), 25, redColor, bigFont.get(), true );
 
     // Timer in center
     int minutes = (int)timeRemaining / 60;
@@ -87,11 +70,12 @@ void HUD::render(SDL_Renderer *renderer, int screenW, int screenH,
         timerColor = goldColor;
     }
 
-    drawText(renderer, oss.str(), screenW / 2, 25, timerColor, bigFont, true);
+    drawText(oss.str(), screenW / 2, 25, timerColor, bigFont.get(), true);
+    if (bigFont) bigFont->flush();
 
     // // Score separator
     // std::string scoreDisplay = std::to_string(score1) + " - " + std::to_string(score2);
-    // drawText(renderer, scoreDisplay, screenW / 2, 8, whiteColor, nullptr, true);
+    // drawText(scoreDisplay, screenW / 2, 8, whiteColor, nullptr, true);
 }
 
 void HUD::renderMessage(SDL_Renderer *renderer, int screenW, int screenH,
@@ -108,5 +92,6 @@ void HUD::renderMessage(SDL_Renderer *renderer, int screenW, int screenH,
 
     // Message text
     SDL_Color gold = {255, 215, 0, 255};
-    drawText(renderer, message, screenW / 2, screenH / 2, gold, bigFont, true);
+    drawText(message, screenW / 2, screenH / 2, gold, bigFont.get(), true);
+    if (bigFont) bigFont->flush();
 }
@@ -0,0 +1,129 @@
+#include "../include/InfluenceMap.h"
+#include "../include/Field.h"
+#include "../include/Obstacle.h"
+#include "../include/PlayerStore.h"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// Building
+// ============================================================================
+void InfluenceMap::build(const Field &f, bool leftSide, const PlayerStore &team,
+                         const PlayerStore &opponents) {
+    if (revision != f.getRevision() || width != f.getWidth() || height != f.getHeight() ||
+        isLeftSide != leftSide || cols == 0) {
+        buildLayout(f, leftSide);
+    }
+    buildDistances(PRESSURE, opponents);
+    buildDistances(COVERAGE, team);
+}
+
+void InfluenceMap::buildLayout(const Field &f, bool leftSide) {
+    revision = f.getRevision();
+    width = f.getWidth();
+    height = f.getHeight();
+    isLeftSide = leftSide;
+    cols = (int)std::floor(width / CELL + 1e-3f) + 1;
+    rows = (int)std::floor(height / CELL + 1e-3f) + 1;
+    for (std::vector<float> &channel : data) channel.assign(cols * rows, 0.0f);
+
+    const float attackX = leftSide ? width : 0.0f;
+    const float defendX = leftSide ? 0.0f : width;
+    const Vector attackGoal(attackX, height / 2.0f);
+    const Vector defendGoal(defendX, height / 2.0f);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            Vector p(c * CELL, r * CELL);
+            int i = r * cols + c;
+            data[CLEARANCE][i] = f.obstacleDistance(p);
+            float shot = f.goalAngle(p, attackX);
+            float threat = f.goalAngle(p, defendX);
+            if (!f.isPathClear(p, attackGoal, Field::BALL_CLEARANCE)) shot *= 0.25f;
+            if (!f.isPathClear(p, defendGoal, Field::BALL_CLEARANCE)) threat *= 0.25f;
+            data[SHOT][i] = shot;
+            data[THREAT][i] = threat;
+        }
+    }
+}
+
+void InfluenceMap::buildDistances(Channel channel, const PlayerStore &players) {
+    // Squared distances, one player at a time over whole rows of nodes
+    // (a loop the compiler vectorises), then one square root per node
+    std::vector<float> &d = data[channel];
+    const float limit2 = MAX_DISTANCE * MAX_DISTANCE;
+    std::fill(d.begin(), d.end(), limit2);
+    for (int k = 0; k < players.size(); ++k) {
+        const float px = players.x[k];
+        const float py = players.y[k];
+        for (int r = 0; r < rows; ++r) {
+            const float dy = r * CELL - py;
+            const float dy2 = dy * dy;
+            if (dy2 >= limit2) continue;
+            float *row = &d[r * cols];
+            for (int c = 0; c < cols; ++c) {
+                float dx = c * CELL - px;
+                float d2 = dx * dx + dy2;
+                row[c] = d2 < row[c] ? d2 : row[c];
+            }
+        }
+    }
+    for (float &v : d) v = std::sqrt(v);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+float InfluenceMap::sample(Channel channel, const Vector &p) const {
+    float fx = std::min(std::max(p.x / CELL, 0.0f), (float)(cols - 1));
+    float fy = std::min(std::max(p.y / CELL, 0.0f), (float)(rows - 1));
+    int i = std::min((int)fx, cols - 2);
+    int j = std::min((int)fy, rows - 2);
+    fx -= i;
+    fy -= j;
+    const float *d = &data[channel][j * cols + i];
+    float top = d[0] + (d[1] - d[0]) * fx;
+    float bottom = d[cols] + (d[cols + 1] - d[cols]) * fx;
+    return top + (bottom - top) * fy;
+}
+
+Vector InfluenceMap::defendSpot(const Vector &ball, const Vector &from,
+                                const std::vector<Vector> &avoid, float spread) const {
+    const Vector goal(isLeftSide ? 0.0f : width, height / 2.0f);
+    // Stand a good way back along the ball's line to goal, but not in it
+    Vector toBall = ball - goal;
+    float back = std::min(std::max(toBall.length() * 0.4f, 3.0f), 12.0f);
+    const Vector ideal = goal + toBall.normalized() * back;
+    const float lineLen2 = std::max(0.0001f, toBall.lengthSquared());
+    const float spread2 = spread * spread;
+
+    Vector best = from;
+    float bestScore = -1e30f;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            Vector p(c * CELL, r * CELL);
+            // Our half only, and nowhere an obstacle is in the way
+            if (std::abs(p.x - goal.x) > width / 2.0f) continue;
+            int i = r * cols + c;
+            if (data[CLEARANCE][i] < Field::STAND_CLEARANCE) continue;
+
+            bool crowded = false;
+            for (const Vector &a : avoid) {
+                if ((p - a).lengthSquared() < spread2) {
+                    crowded = true;
+                    break;
+                }
+            }
+            if (crowded) continue;
+
+            float t = std::min(std::max((p - goal).dot(toBall) / lineLen2, 0.0f), 1.0f);
+            float lineDist = (p - (goal + toBall * t)).length();
+            float score = data[THREAT][i] * 4.0f - lineDist - 0.5f * (p - ideal).length() -
+                          0.1f * (p - from).length();
+            if (score > bestScore) {
+                bestScore = score;
+                best = p;
+            }
+        }
+    }
+    return best;
+}
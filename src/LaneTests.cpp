@@ -0,0 +1,203 @@
+#include "../include/LaneTests.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+// SSE2 is part of the x86-64 baseline; 32-bit builds use the scalar path.
+#if defined(__x86_64__) || defined(_M_X64)
+#define LANE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions inside functions marked for
+// it; the rest of the program keeps the baseline instruction set.
+#if defined(LANE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define LANE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LANE_TARGET_AVX2
+#endif
+
+// Squared distance before any point is seen (sqrt gives 1e15).
+static const float FAR2 = 1e30f;
+
+// ============================================================================
+// Scalar
+// ============================================================================
+// Smallest squared point distance to segments [begin, end).  The arithmetic
+// mirrors AIAgent::minOpponentDistanceToSegment exactly.
+static void minDist2Scalar(const LaneBatch &l, int begin, int end,
+                           const float *px, const float *py, int n, float *out) {
+    for (int s = begin; s < end; ++s) {
+        const float ax = l.ax[s], ay = l.ay[s];
+        const float abx = l.bx[s] - ax;
+        const float aby = l.by[s] - ay;
+        const float len2 = std::max(0.0001f, abx * abx + aby * aby);
+        float best2 = FAR2;
+        for (int j = 0; j < n; ++j) {
+            float t = (abx * (px[j] - ax) + aby * (py[j] - ay)) / len2;
+            t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+            float dx = px[j] - (ax + abx * t);
+            float dy = py[j] - (ay + aby * t);
+            float d2 = dx * dx + dy * dy;
+            best2 = d2 < best2 ? d2 : best2;
+        }
+        out[s] = best2;
+    }
+}
+
+#ifdef LANE_X86
+// ============================================================================
+// SSE2 (4 segments per step)
+// ============================================================================
+static int minDist2SSE2(const LaneBatch &l, const float *px, const float *py, int n,
+                        float *out) {
+    const int count = l.size() & ~3;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minLen2 = _mm_set1_ps(0.0001f);
+    for (int s = 0; s < count; s += 4) {
+        __m128 ax = _mm_loadu_ps(&l.ax[s]);
+        __m128 ay = _mm_loadu_ps(&l.ay[s]);
+        __m128 abx = _mm_sub_ps(_mm_loadu_ps(&l.bx[s]), ax);
+        __m128 aby = _mm_sub_ps(_mm_loadu_ps(&l.by[s]), ay);
+        __m128 len2 = _mm_max_ps(minLen2, _mm_add_ps(_mm_mul_ps(abx, abx),
+                                                     _mm_mul_ps(aby, aby)));
+        __m128 best2 = _mm_set1_ps(FAR2);
+        for (int j = 0; j < n; ++j) {
+            __m128 ox = _mm_set1_ps(px[j]);
+            __m128 oy = _mm_set1_ps(py[j]);
+            __m128 t = _mm_div_ps(_mm_add_ps(_mm_mul_ps(abx, _mm_sub_ps(ox, ax)),
+                                             _mm_mul_ps(aby, _mm_sub_ps(oy, ay))),
+                                  len2);
+            t = _mm_min_ps(_mm_max_ps(t, zero), one);
+            __m128 dx = _mm_sub_ps(ox, _mm_add_ps(ax, _mm_mul_ps(abx, t)));
+            __m128 dy = _mm_sub_ps(oy, _mm_add_ps(ay, _mm_mul_ps(aby, t)));
+            __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            best2 = _mm_min_ps(d2, best2);
+        }
+        _mm_storeu_ps(&out[s], best2);
+    }
+    return count;
+}
+
+// ============================================================================
+// AVX2 (8 segments per step)
+// ============================================================================
+LANE_TARGET_AVX2
+static int minDist2AVX2(const LaneBatch &l, const float *px, const float *py, int n,
+                        float *out) {
+    const int count = l.size() & ~7;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minLen2 = _mm256_set1_ps(0.0001f);
+    for (int s = 0; s < count; s += 8) {
+        __m256 ax = _mm256_loadu_ps(&l.ax[s]);
+        __m256 ay = _mm256_loadu_ps(&l.ay[s]);
+        __m256 abx = _mm256_sub_ps(_mm256_loadu_ps(&l.bx[s]), ax);
+        __m256 aby = _mm256_sub_ps(_mm256_loadu_ps(&l.by[s]), ay);
+        __m256 len2 = _mm256_max_ps(minLen2, _mm256_add_ps(_mm256_mul_ps(abx, abx),
+                                                           _mm256_mul_ps(aby, aby)));
+        __m256 best2 = _mm256_set1_ps(FAR2);
+        for (int j = 0; j < n; ++j) {
+            __m256 ox = _mm256_set1_ps(px[j]);
+            __m256 oy = _mm256_set1_ps(py[j]);
+            __m256 t = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(abx, _mm256_sub_ps(ox, ax)),
+                                                   _mm256_mul_ps(aby, _mm256_sub_ps(oy, ay))),
+                                     len2);
+            t = _mm256_min_ps(_mm256_max_ps(t, zero), one);
+            __m256 dx = _mm256_sub_ps(ox, _mm256_add_ps(ax, _mm256_mul_ps(abx, t)));
+            __m256 dy = _mm256_sub_ps(oy, _mm256_add_ps(ay, _mm256_mul_ps(aby, t)));
+            __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            best2 = _mm256_min_ps(d2, best2);
+        }
+        _mm256_storeu_ps(&out[s], best2);
+    }
+    return count;
+}
+
+static bool cpuHasAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    // The OS must also save the YMM registers on context switches
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return avx2 && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+    return false;
+#endif
+}
+#endif  // LANE_X86
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+LaneSimd laneSimdSupported() {
+#ifdef LANE_X86
+    static const LaneSimd best = cpuHasAVX2() ? LaneSimd::AVX2 : LaneSimd::SSE2;
+    return best;
+#else
+    return LaneSimd::SCALAR;
+#endif
+}
+
+// -1 = not chosen yet (use the best supported level)
+static std::atomic<int> forcedLevel(-1);
+
+LaneSimd laneSimdLevel() {
+    int level = forcedLevel.load(std::memory_order_relaxed);
+    return level < 0 ? laneSimdSupported() : (LaneSimd)level;
+}
+
+void setLaneSimdLevel(LaneSimd level) {
+    forcedLevel.store((int)std::min(level, laneSimdSupported()), std::memory_order_relaxed);
+}
+
+// Squared minimum distances of every segment, widest kernel first and the
+// leftover segments in scalar code.
+static void minDist2(const LaneBatch &lanes, const float *px, const float *py, int n,
+                     float *out) {
+    int done = 0;
+#ifdef LANE_X86
+    switch (laneSimdLevel()) {
+    case LaneSimd::AVX2:
+        done = minDist2AVX2(lanes, px, py, n, out);
+        break;
+    case LaneSimd::SSE2:
+        done = minDist2SSE2(lanes, px, py, n, out);
+        break;
+    case LaneSimd::SCALAR:
+        break;
+    }
+#endif
+    minDist2Scalar(lanes, done, lanes.size(), px, py, n, out);
+}
+
+void laneDistances(const LaneBatch &lanes, const float *px, const float *py, int n,
+                   float *minDist) {
+    minDist2(lanes, px, py, n, minDist);
+    for (int s = 0; s < lanes.size(); ++s) {
+        minDist[s] = std::sqrt(minDist[s]);
+    }
+}
+
+void laneClearMask(const LaneBatch &lanes, const float *px, const float *py, int n,
+                   float clearance, uint64_t *mask) {
+    static thread_local std::vector<float> dist;
+    dist.resize(lanes.size());
+    laneDistances(lanes, px, py, n, dist.data());
+
+    int words = (lanes.size() + 63) / 64;
+    for (int w = 0; w < words; ++w) mask[w] = 0;
+    for (int s = 0; s < lanes.size(); ++s) {
+        if (dist[s] > clearance) mask[s >> 6] |= (uint64_t)1 << (s & 63);
+    }
+}
@@ -0,0 +1,218 @@
+#include "../include/Field.h"
+#include "../include/Obstacle.h"
+#include "../include/Ball.h"
+#include "../include/Team.h"
+#include "../include/ShapeBatch.h"
+#include "../include/Camera.h"
+#include "../include/SpriteAtlas.h"
+#include <cmath>
+#include <vector>
+
+// The render() members of the match objects.  They live in sigma_render
+// with the batch, camera and atlas they draw through, so sigma_core and the
+// headless tools built on it never need the SDL 2.0.18 geometry API.
+
+// ============================================================================
+// Field
+// ============================================================================
+void Field::render(ShapeBatch &batch, const Camera &camera,
+                      const SpriteAtlas *sprites) const {
+    SDL_FRect bg = camera.getPitchRect();
+    if (sprites && sprites->has(Sprite::FIELD)) {
+        sprites->draw(batch, Sprite::FIELD, bg);
+    } else {
+        // field background - dark green
+        batch.fillRect(bg, SDL_Color{30, 120, 60, 255});
+    }
+
+    // Draw center line (in world coords x = width/2 from y=0..height)
+    const SDL_Color faintWhite = {255, 255, 255, 100};
+    SDL_FPoint p1 = camera.worldToScreen(width / 2.0f, 0.0f);
+    SDL_FPoint p2 = camera.worldToScreen(width / 2.0f, height);
+    batch.line(std::floor(p1.x), std::floor(p1.y), std::floor(p2.x), std::floor(p2.y),
+               1.0f, faintWhite);
+
+    // Draw center circle (the old point-by-point version was drawn in the
+    // same colour as the centre line)
+    float circleR = std::floor(camera.pixels(3.0f));
+    SDL_FPoint center = camera.worldToScreen(width / 2.0f, height / 2.0f);
+    batch.ring(std::floor(center.x) + 0.5f, std::floor(center.y) + 0.5f, circleR + 0.5f,
+               1.0f, faintWhite);
+
+    // Draw goal zones, inside the pitch at each end
+    SDL_FRect leftGoal = camera.worldRect(0.0f, getGoalTop(), goalDepth, goalHeight);
+    batch.fillRect(leftGoal, SDL_Color{50, 100, 200, 120});
+    batch.drawRect(leftGoal, 1.0f, SDL_Color{100, 150, 255, 255});
+
+    SDL_FRect rightGoal = camera.worldRect(width - goalDepth, getGoalTop(), goalDepth, goalHeight);
+    batch.fillRect(rightGoal, SDL_Color{200, 50, 50, 120});
+    batch.drawRect(rightGoal, 1.0f, SDL_Color{255, 100, 100, 255});
+
+    // Draw the four barriers as a thin white border around the pitch
+    const SDL_Color white = {255, 255, 255, 255};
+    float left = bg.x;
+    float top = bg.y;
+    float right = bg.x + bg.w - 1;
+    float bottom = bg.y + bg.h - 1;
+    float gt = leftGoal.y;
+    float gb = leftGoal.y + leftGoal.h;
+    // Top wall
+    batch.line(left, top, right + 1, top, 1.0f, white);
+    // Bottom wall
+    batch.line(left, bottom, right + 1, bottom, 1.0f, white);
+    // Left wall (excluding goal opening)
+    batch.line(left, top, left, gt, 1.0f, white);
+    batch.line(left, gb, left, bottom + 1, 1.0f, white);
+    // Right wall (excluding goal opening)
+    batch.line(right, top, right, gt, 1.0f, white);
+    batch.line(right, gb, right, bottom + 1, 1.0f, white);
+
+    // render any obstacles after field elements so they appear on top
+    for (const Obstacle &obs : obstacles) {
+        obs.render(batch, camera);
+    }
+}
+
+// ============================================================================
+// Obstacle
+// ============================================================================
+void Obstacle::render(ShapeBatch &batch, const Camera &camera) const {
+    const SDL_Color fill = {100, 100, 100, 255};
+    const SDL_Color edge = {255, 255, 255, 255};
+
+    if (shape == ObstacleShape::RECT) {
+        SDL_FRect rect = camera.worldRect(pos.x - width / 2.0f, pos.y - height / 2.0f,
+                                          width, height);
+
+        batch.fillRect(rect, fill);
+        batch.drawRect(rect, 1.0f, edge);
+        return;
+    }
+
+    // Circles and polygons: fill the outline with triangles, then draw it
+    static thread_local std::vector<SDL_FPoint> outline;
+    outline.clear();
+    if (shape == ObstacleShape::CIRCLE) {
+        for (int deg = 0; deg < 360; deg += 6) {
+            float rad = deg * 3.14159f / 180.0f;
+            outline.push_back(camera.worldToScreen(pos.x + getRadius() * std::cos(rad),
+                                                   pos.y + getRadius() * std::sin(rad)));
+        }
+    } else {
+        for (const Vector &p : points) {
+            outline.push_back(camera.worldToScreen(p));
+        }
+    }
+
+    if (shape == ObstacleShape::CIRCLE) {
+        batch.fillConvex(outline.data(), (int)outline.size(), fill);
+    } else {
+        batch.fillPolygon(outline.data(), (int)outline.size(), fill);
+    }
+    batch.drawPolygon(outline.data(), (int)outline.size(), 1.0f, edge);
+}
+
+// ============================================================================
+// Ball
+// ============================================================================
+void Ball::render(ShapeBatch &batch, const Camera &camera,
+                  const SpriteAtlas *sprites) const {
+    SDL_FPoint p = camera.worldToScreen(pos);
+    int px = static_cast<int>(p.x);
+    int py = static_cast<int>(p.y);
+
+    // compute radius in pixels; prefer uniform scaling so ball remains circular
+    int pr = static_cast<int>(camera.pixels(radius));
+    if (pr < 4) pr = 4;
+
+    SDL_FRect dst{ (float)(px - pr), (float)(py - pr), (float)(pr * 2), (float)(pr * 2) };
+    if (sprites && sprites->has(Sprite::BALL)) {
+        sprites->draw(batch, Sprite::BALL, dst);
+    } else if (sprites && sprites->has(Sprite::DISC)) {
+        // Same puck, from the atlas so it joins the players' draw call
+        sprites->draw(batch, Sprite::DISC, dst, SDL_Color{255, 255, 255, 255});
+        sprites->draw(batch, Sprite::RING, dst, SDL_Color{200, 200, 200, 255});
+    } else {
+        // Draw a white puck with a subtle border
+        batch.fillCircle((float)px, (float)py, (float)pr, SDL_Color{255, 255, 255, 255});
+        batch.ring((float)px, (float)py, (float)pr, 1.0f, SDL_Color{200, 200, 200, 255});
+    }
+}
+
+// ============================================================================
+// Team
+// ============================================================================
+// draw one player at screen position (px, py): tinted player sprite or
+// disc from the atlas, otherwise a circle
+static void drawPlayer(ShapeBatch &batch, const Camera &camera,
+                       float screenX, float screenY, float radius,
+                       SDL_Color color, const SpriteAtlas *sprites) {
+    int px = static_cast<int>(screenX);
+    int py = static_cast<int>(screenY);
+    int pr = static_cast<int>(camera.pixels(radius));
+    if (pr < 6) pr = 6;
+
+    if (sprites && sprites->has(Sprite::PLAYER)) {
+        // Draw the player sprite, tinted with team color
+        // Scale sprite to fit nicely on the field
+        int spriteSize = pr * 3;  // 1.5x diameter
+        SDL_FRect dst = { (float)(px - spriteSize / 2), (float)(py - spriteSize / 2),
+                          (float)spriteSize, (float)spriteSize };
+        sprites->draw(batch, Sprite::PLAYER, dst, color);
+    } else if (sprites && sprites->has(Sprite::DISC)) {
+        // Circle with an outline, as two tinted atlas quads
+        SDL_FRect dst = { (float)(px - pr), (float)(py - pr), (float)(pr * 2), (float)(pr * 2) };
+        sprites->draw(batch, Sprite::DISC, dst, color);
+        sprites->draw(batch, Sprite::RING, dst, SDL_Color{255, 255, 255, 200});
+    } else {
+        // Fallback: draw circle with an outline
+        batch.fillCircle((float)px, (float)py, (float)pr, color);
+        batch.ring((float)px, (float)py, (float)pr, 1.0f, SDL_Color{255, 255, 255, 200});
+    }
+}
+
+void Team::render(ShapeBatch &batch, const Camera &camera,
+                  SDL_Color activeColor, SDL_Color inactiveColor,
+                  const SpriteAtlas *sprites) const {
+    if (players.size() == 0) return;
+
+    // Every player's screen position in one pass
+    static thread_local std::vector<float> screenX, screenY;
+    screenX.resize(players.size());
+    screenY.resize(players.size());
+    camera.transform(players.x.data(), players.y.data(), players.size(),
+                     screenX.data(), screenY.data());
+
+    // Draw inactive players (dimmer)
+    for (int i = 0; i < players.size(); ++i) {
+        if (i == activeIndex) continue;
+        drawPlayer(batch, camera, screenX[i], screenY[i], players.radius[i],
+                   inactiveColor, sprites);
+    }
+
+    // Draw active player (brighter) on top
+    float activeRadius = players.radius[activeIndex];
+    drawPlayer(batch, camera, screenX[activeIndex], screenY[activeIndex], activeRadius,
+               activeColor, sprites);
+
+    // Draw an indicator arrow above the active player
+    int ax = static_cast<int>(screenX[activeIndex]);
+    int ay = static_cast<int>(screenY[activeIndex]);
+    int arrPr = static_cast<int>(camera.pixels(activeRadius));
+    if (arrPr < 6) arrPr = 6;
+    int sprHalf = arrPr * 3 / 2; // match sprite half-size
+
+    // Small triangle above player sprite
+    const SDL_Color yellow = {255, 255, 0, 255};
+    float triTop = (float)(ay - sprHalf - 12);
+    float triBot = (float)(ay - sprHalf - 4);
+    if (sprites && sprites->has(Sprite::MARKER)) {
+        // Apex and base corners land on the same pixel centres as the lines
+        sprites->draw(batch, Sprite::MARKER,
+                      SDL_FRect{(float)(ax - 5), triTop, 11.0f, 9.0f}, yellow);
+        return;
+    }
+    batch.line((float)ax, triTop, (float)(ax - 5), triBot, 1.0f, yellow);
+    batch.line((float)ax, triTop, (float)(ax + 5), triBot, 1.0f, yellow);
+    batch.line((float)(ax - 5), triBot, (float)(ax + 5), triBot, 1.0f, yellow);
+}
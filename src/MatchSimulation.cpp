@@ -0,0 +1,362 @@
+#include "../include/MatchSimulation.h"
+#include "../include/Replay.h"
+#include "../include/Profiler.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+
+// ============================================================================
+// Construction
+// ============================================================================
+MatchSimulation::MatchSimulation(const Field &f, GameMode m, float matchDuration,
+                                 int playersPerTeam, uint32_t seed)
+    : field(f),
+      // Ball starts at center, stationary
+      ball(Vector(f.getWidth() / 2.0f, f.getHeight() / 2.0f), Vector(0, 0), 0.5f),
+      // Team 1 (Blue, left side) - WASD + E to swap
+      team1(kickoffFormation(f, playersPerTeam, true),
+            KeyBindings{SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D, SDLK_e}),
+      // Team 2 (Red, right side) - Arrow keys + Right Shift to swap
+      team2(kickoffFormation(f, playersPerTeam, false),
+            KeyBindings{SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDLK_RSHIFT}),
+      playerGrid(f.getWidth(), f.getHeight()),
+      ai1(0.7f),  // Team 1 AI
+      ai2(0.8f),  // Team 2 AI (slightly faster reaction for full AI team)
+      navigator(std::make_shared<Navigator>()),
+      mode(m),
+      seed(seed),
+      rngState(seed),
+      matchTime(matchDuration),
+      gameOver(false),
+      accumulator(0.0f),
+      pendingSwap1(false),
+      pendingSwap2(false),
+      prevBall(ball),
+      prevTeam1(team1),
+      prevTeam2(team2),
+      recorder(nullptr),
+      pool(nullptr) {
+    ai1.setNavigator(navigator);
+    ai2.setNavigator(navigator);
+    if (seed != 0) resetPositions();
+}
+
+Field MatchSimulation::createDefaultField() {
+    Field field(40.0f, 20.0f);
+    // place a couple of fixed obstacles on the pitch for testing
+    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.5f,
+                                      field.getHeight() * 0.5f),
+                               4.0f, 4.0f));
+    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.2f,
+                                      field.getHeight() * 0.2f),
+                               1.25f, 3.0f));
+    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.8f,
+                                      field.getHeight() * 0.8f),
+                               1.25f, 3.0f));
+    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.75f,
+                                      field.getHeight() * 0.25f),
+                               4.0f, 1.0f));
+    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.25f,
+                                      field.getHeight() * 0.75f),
+                               4.0f, 1.0f));
+    return field;
+}
+
+// ============================================================================
+// Match control
+// ============================================================================
+void MatchSimulation::restart(float matchDuration) {
+    team1.score = 0;
+    team2.score = 0;
+    matchTime = matchDuration;
+    gameOver = false;
+    accumulator = 0.0f;
+    pendingSwap1 = pendingSwap2 = false;
+    rngState = seed;
+    resetPositions();
+}
+
+void MatchSimulation::setTeamAI(int team, const AIAgent &ai) {
+    AIAgent &slot = (team == 1) ? ai1 : ai2;
+    slot = ai;
+    slot.setNavigator(navigator);
+}
+
+int MatchSimulation::getLeader() const {
+    if (team1.score > team2.score) return 1;
+    if (team2.score > team1.score) return 2;
+    return 0;
+}
+
+// Players are spread over up to a few columns in the team's own half.
+// A 2-player team lines up at 20% of the pitch width, 35% / 65% down.
+std::vector<Vector> MatchSimulation::kickoffFormation(const Field &field, int n,
+                                                      bool isLeftSide) {
+    std::vector<Vector> starts;
+    int cols = (n + 3) / 4;
+    for (int c = 0; c < cols; ++c) {
+        int m = n / cols + (c < n % cols ? 1 : 0);
+        float fx = (cols == 1) ? 0.2f : 0.08f + c * (0.4f - 0.08f) / (cols - 1);
+        float x = isLeftSide ? field.getWidth() * fx
+                             : field.getWidth() * (1.0f - fx);
+        float gap = std::min(0.3f, 0.9f / m);
+        for (int k = 0; k < m; ++k) {
+            float fy = 0.5f + (k - (m - 1) * 0.5f) * gap;
+            starts.push_back(Vector(x, field.getHeight() * fy));
+        }
+    }
+    return starts;
+}
+
+// How far (metres, per axis) a seeded kick-off may move each player.
+static const float KICKOFF_JITTER = 0.5f;
+
+float MatchSimulation::nextJitter() {
+    // xorshift32; never reaches 0 from a non-zero seed
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (float)(rngState >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+// Reset positions after a goal
+void MatchSimulation::resetPositions() {
+    // Team 1 on left side, Team 2 on right side
+    std::vector<Vector> starts1 = kickoffFormation(field, team1.size(), true);
+    std::vector<Vector> starts2 = kickoffFormation(field, team2.size(), false);
+    if (seed != 0) {
+        // x then y, in a fixed order so every compiler draws the same values
+        for (std::vector<Vector> *starts : {&starts1, &starts2}) {
+            for (Vector &p : *starts) {
+                p.x += nextJitter() * KICKOFF_JITTER;
+                p.y += nextJitter() * KICKOFF_JITTER;
+            }
+        }
+    }
+    team1.resetPositions(starts1);
+    team2.resetPositions(starts2);
+    // Ball to center
+    ball.reset(Vector(field.getWidth() / 2.0f, field.getHeight() / 2.0f), Vector(0, 0));
+
+    prevBall = ball;
+    prevTeam1 = team1;
+    prevTeam2 = team2;
+}
+
+// ============================================================================
+// Step
+// ============================================================================
+MatchEvent MatchSimulation::step(float dt, const MatchInputs &inputs) {
+    if (gameOver) return MatchEvent::NONE;
+
+    if (recorder) recorder->recordStep(inputs);
+
+    prevBall = ball;
+    prevTeam1 = team1;
+    prevTeam2 = team2;
+
+    updateTeams(dt, inputs);
+
+    // ---- Player-to-player collision resolution ----
+    // Prevents players from overlapping each other
+    {
+        PROFILE_SCOPE(ProfileZone::COLLISION);
+        resolveAllPlayerCollisions(team1, team2, playerGrid);
+    }
+
+    MatchEvent event = MatchEvent::NONE;
+    int goalResult = resolveCollisions(dt);
+    if (goalResult == 1) {
+        // Left goal - Team 2 scores
+        team2.score++;
+        event = MatchEvent::TEAM2_GOAL;
+        resetPositions();
+    } else if (goalResult == 2) {
+        // Right goal - Team 1 scores
+        team1.score++;
+        event = MatchEvent::TEAM1_GOAL;
+        resetPositions();
+    }
+
+    if (goalResult == 0) {
+        team1.players.measureVelocities(prevTeam1.players, dt);
+        team2.players.measureVelocities(prevTeam2.players, dt);
+    }
+
+    // Update timer
+    matchTime -= dt;
+    if (matchTime <= 0.0f) {
+        matchTime = 0.0f;
+        gameOver = true;
+        event = MatchEvent::MATCH_OVER;
+    }
+    return event;
+}
+
+MatchEvent MatchSimulation::advance(float frameDt, const MatchInputs &inputs) {
+    // Avoid a spiral of death after a long stall (window drag, breakpoint)
+    if (frameDt > 0.25f) frameDt = 0.25f;
+
+    pendingSwap1 = pendingSwap1 || inputs.team1.swap;
+    pendingSwap2 = pendingSwap2 || inputs.team2.swap;
+    return runFixedSteps(frameDt, inputs, nullptr);
+}
+
+MatchEvent MatchSimulation::advance(float frameDt, ReplayPlayer &replay, float speed) {
+    if (frameDt > 0.25f) frameDt = 0.25f;
+    return runFixedSteps(frameDt * speed, MatchInputs(), &replay);
+}
+
+MatchEvent MatchSimulation::runFixedSteps(float simDt, const MatchInputs &live,
+                                          ReplayPlayer *replay) {
+    accumulator += simDt;
+
+    MatchEvent result = MatchEvent::NONE;
+    while (accumulator >= FIXED_DT && !gameOver) {
+        MatchInputs stepInputs = live;
+        if (replay) {
+            if (!replay->nextInputs(stepInputs)) break;
+        } else {
+            stepInputs.team1.swap = pendingSwap1;
+            stepInputs.team2.swap = pendingSwap2;
+            pendingSwap1 = pendingSwap2 = false;
+        }
+
+        MatchEvent ev = step(FIXED_DT, stepInputs);
+        if (ev > result) result = ev;
+        accumulator -= FIXED_DT;
+    }
+    // Nothing left to simulate: hold the final state on screen
+    if (gameOver || (replay && replay->isFinished())) {
+        accumulator = FIXED_DT;
+    }
+    return result;
+}
+
+uint64_t MatchSimulation::stateHash() const {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](const void *data, size_t size) {
+        const unsigned char *bytes = (const unsigned char *)data;
+        for (size_t i = 0; i < size; ++i) {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+    };
+    mix(&ball.pos, sizeof(Vector));
+    mix(&ball.vel, sizeof(Vector));
+    const Team *teams[2] = {&team1, &team2};
+    for (const Team *t : teams) {
+        const PlayerStore &p = t->players;
+        mix(p.x.data(), p.x.size() * sizeof(float));
+        mix(p.y.data(), p.y.size() * sizeof(float));
+        mix(&t->activeIndex, sizeof(int));
+        mix(&t->score, sizeof(int));
+    }
+    mix(&matchTime, sizeof(float));
+    return h;
+}
+
+// ============================================================================
+// Render interpolation
+// ============================================================================
+Ball MatchSimulation::getRenderBall() const {
+    Ball b = ball;
+    b.pos = prevBall.pos.lerp(ball.pos, getInterpolationAlpha());
+    return b;
+}
+
+Team MatchSimulation::interpolateTeam(const Team &prev, const Team &cur) const {
+    float alpha = getInterpolationAlpha();
+    Team t = cur;
+    t.players.interpolate(prev.players, cur.players, alpha);
+    return t;
+}
+
+Team MatchSimulation::getRenderTeam1() const { return interpolateTeam(prevTeam1, team1); }
+Team MatchSimulation::getRenderTeam2() const { return interpolateTeam(prevTeam2, team2); }
+
+void MatchSimulation::updateTeams(float dt, const MatchInputs &inputs) {
+    PROFILE_SCOPE(ProfileZone::AI);
+    // Neither side sees what the other decides this step: both read the
+    // snapshot taken at the start of the step and write only their own
+    // team, so they can run at the same time.  Kicks are the only writes
+    // to shared state (the ball) and are applied once both are done, team
+    // 1 first, whichever side finished first.
+    if (pool) {
+        pool->submit([this, dt, &inputs]() { updateSide(2, dt, inputs); });
+        updateSide(1, dt, inputs);
+        pool->wait();
+    } else {
+        updateSide(1, dt, inputs);
+        updateSide(2, dt, inputs);
+    }
+
+    if (mode == MODE_AI_VS_AI) applyAIKicks(ai1, team1);
+    if (mode != MODE_PVP) applyAIKicks(ai2, team2);
+}
+
+void MatchSimulation::updateSide(int side, float dt, const MatchInputs &inputs) {
+    const bool left = (side == 1);
+    Team &team = left ? team1 : team2;
+    AIAgent &ai = left ? ai1 : ai2;
+    const Team &opponents = left ? prevTeam2 : prevTeam1;
+    // Team 1 is human-controlled unless both sides are AI, team 2 only in PvP
+    const bool human = left ? (mode != MODE_AI_VS_AI) : (mode == MODE_PVP);
+
+    if (human) {
+        // Active player follows the input; the AI moves the inactive ones
+        team.update(dt, left ? inputs.team1 : inputs.team2, &field);
+        ai.updateInfluence(field, left, team.players, opponents.players);
+        for (int i = 0; i < team.size(); ++i) {
+            if (i != team.activeIndex) ai.update(dt, team, i, prevBall, field, left);
+        }
+    } else {
+        // Full AI: updateTeam handles every player with Active/Support
+        // roles, passing logic, and steering behaviors
+        ai.updateTeam(dt, team, prevBall, field, left, opponents);
+    }
+}
+
+void MatchSimulation::applyAIKicks(const AIAgent &ai, Team &team) {
+    // Handle passing: when AI decides to pass, apply force to ball
+    if (ai.didJustPass() && ai.getPassReceiver() >= 0) {
+        Vector receiverPos = team.players.getPos(ai.getPassReceiver());
+
+        Vector passDir = (receiverPos - ball.pos).normalized();
+        float passDist = (receiverPos - ball.pos).length();
+        float passSpeed = std::min(25.0f, std::max(12.0f, passDist * 1.2f));
+        ball.vel = passDir * passSpeed;
+    }
+
+    // Handle shooting: when AI decides to shoot, launch ball at goal
+    if (ai.didJustShoot()) {
+        Vector target = ai.getShotTarget();
+        Vector shotDir = (target - ball.pos).normalized();
+        float shotDist = (target - ball.pos).length();
+        // Shot speed: faster than pass, scales with distance
+        float shotSpeed = std::min(30.0f, std::max(18.0f, shotDist * 1.5f));
+        ball.vel = shotDir * shotSpeed;
+    }
+}
+
+int MatchSimulation::resolveCollisions(float dt) {
+    PROFILE_SCOPE(ProfileZone::COLLISION);
+    // player-obstacle resolution
+    field.handlePlayerCollisions(team1.players);
+    field.handlePlayerCollisions(team2.players);
+
+    // Players that walked into the ball this step kick it
+    ball.handlePlayerCollisions(team1.players);
+    ball.handlePlayerCollisions(team2.players);
+
+    // Undo any overlap with walls/obstacles left by those kicks (this also
+    // catches a ball shoved over a goal line)
+    int goalResult = field.handleCollision(ball);
+
+    // Then sweep the ball along its velocity, bouncing off everything it
+    // meets on the way
+    if (goalResult == 0) {
+        goalResult = field.moveBall(ball, dt, team1.players, team2.players);
+    }
+    ball.applyFriction(dt);
+    return goalResult;
+}
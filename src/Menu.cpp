@@ -1,49 +1,30 @@
 #include "../include/Menu.h"
 #include <SDL.h>
-#include <SDL_ttf.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <iostream>
+#include <memory>
 
 // Global settings with defaults
-GameSettings gSettings = { 120 }; // 2 minutes default
-
-// -----------------------------------------------------------------------------
-// Helper: draw centered text in a rect
-// -----------------------------------------------------------------------------
-static void drawText(SDL_Renderer* renderer, TTF_Font* font,
-                     const std::string &text, SDL_Rect dst, SDL_Color color) {
-    SDL_Surface* surf = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!surf) return;
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (tex) {
-        SDL_Rect r = dst;
-        r.w = surf->w;
-        r.h = surf->h;
-        r.x += (dst.w - surf->w) / 2;
-        r.y += (dst.h - surf->h) / 2;
-        SDL_RenderCopy(renderer, tex, nullptr, &r);
-        SDL_DestroyTexture(tex);
-    }
-    SDL_FreeSurface(surf);
+GameSettings gSettings = { 120, 2, 0 }; // 2 minutes, 2v2, normal AI default
+
+float aiPlanBudget(int aiLevel) {
+    // The planner plays better the more rollouts fit in its budget; the
+    // match runs at 120 steps a second on its own thread, so even expert
+    // leaves most of each step free
+    static const float budgets[] = {0.0f, 0.0005f, 0.002f};
+    return budgets[std::min(std::max(aiLevel, 0), 2)];
 }
 
-// Helper: draw centered text at absolute position
-static void drawTextCentered(SDL_Renderer* renderer, TTF_Font* font,
-                              const std::string &text, int cx, int cy, SDL_Color color) {
-    SDL_Surface* surf = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!surf) return;
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (tex) {
-        SDL_Rect r;
-        r.w = surf->w;
-        r.h = surf->h;
-        r.x = cx - surf->w / 2;
-        r.y = cy - surf->h / 2;
-        SDL_RenderCopy(renderer, tex, nullptr, &r);
-        SDL_DestroyTexture(tex);
-    }
-    SDL_FreeSurface(surf);
+// Menu fonts, shared with the HUD through SDLFramework::getFont
+static const char* BODY_FONT = "assets/fonts/mohave-semibold.otf";
+static const char* TITLE_FONT = "assets/fonts/LEMONMILK-Medium.otf";
+
+// Draw the text queued on both atlases this frame
+static void flushText(FontAtlas* font, FontAtlas* titleFont) {
+    if (titleFont) titleFont->flush();
+    if (font) font->flush();
 }
 
 // =============================================================================
@@ -53,17 +34,9 @@ bool showResolutionMenu(SDLFramework &app) {
     SDL_Renderer* renderer = app.getRenderer();
     if (!renderer) return false;
 
-    if (TTF_Init() == -1) {
-        std::cerr << "TTF_Init failed: " << TTF_GetError() << std::endl;
-        return false;
-    }
-
-    TTF_Font* font = TTF_OpenFont("assets/fonts/mohave-semibold.otf", 24);
-    if (!font) {
-        std::cerr << "Could not load font: " << TTF_GetError() << std::endl;
-        TTF_Quit();
-        return false;
-    }
+    std::shared_ptr<FontAtlas> font = app.getFont(BODY_FONT, 24);
+    if (!font) return false;
+    std::shared_ptr<FontAtlas> titleFont = app.getFont(TITLE_FONT, 36);
 
     std::vector<std::pair<int,int>> options = {
         {800,600}, {1024,768}, {1280,720}, {1366,768}, {1920,1080}
@@ -75,7 +48,6 @@ bool showResolutionMenu(SDLFramework &app) {
     while (menuRunning) {
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) {
-                TTF_CloseFont(font);
                 return false;
             }
             if (e.type == SDL_KEYDOWN) {
@@ -87,16 +59,13 @@ bool showResolutionMenu(SDLFramework &app) {
                         selected = (selected + 1) % (int)options.size();
                         break;
                     case SDLK_ESCAPE:
-                        TTF_CloseFont(font);
                         return false;
                     case SDLK_RETURN:
                     case SDLK_KP_ENTER: {
                         int w = options[selected].first;
                         int h = options[selected].second;
                         std::cout << "Applying resolution: " << w << "x" << h << std::endl;
-                        bool ok = app.setResolution(w, h);
-                        TTF_CloseFont(font);
-                        return ok;
+                        return app.setResolution(w, h);
                     }
                     default: break;
                 }
@@ -110,10 +79,8 @@ bool showResolutionMenu(SDLFramework &app) {
         SDL_RenderClear(renderer);
 
         // Title
-        TTF_Font* titleFont = TTF_OpenFont("assets/fonts/LEMONMILK-Medium.otf", 36);
         if (titleFont) {
-            drawTextCentered(renderer, titleFont, "RESOLUTION", winW / 2, 60, {255, 215, 0, 255});
-            TTF_CloseFont(titleFont);
+            titleFont->drawCentered("RESOLUTION", winW / 2, 60, {255, 215, 0, 255});
         }
 
         int itemH = 55;
@@ -141,18 +108,19 @@ bool showResolutionMenu(SDLFramework &app) {
 
             std::string resText = std::to_string(options[i].first) + " x " + std::to_string(options[i].second);
             SDL_Color textColor = ((int)i == selected) ? SDL_Color{255, 255, 255, 255} : SDL_Color{160, 160, 180, 255};
-            drawText(renderer, font, resText, r, textColor);
+            font->drawInRect(resText, r, textColor);
         }
 
         // Instructions
-        drawTextCentered(renderer, font, "UP/DOWN to select, ENTER to apply, ESC to go back",
-                         winW / 2, winH - 40, {120, 120, 140, 255});
+        font->drawCentered("UP/DOWN to select, ENTER to apply, ESC to go back",
+                           winW / 2, winH - 40, {120, 120, 140, 255});
 
+        flushText(font.get(), titleFont.get());
+        app.getAssets().update();
         SDL_RenderPresent(renderer);
         SDL_Delay(16);
     }
 
-    TTF_CloseFont(font);
     return false;
 }
 
@@ -163,17 +131,9 @@ MainMenuChoice showMainMenu(SDLFramework &app) {
     SDL_Renderer* renderer = app.getRenderer();
     if (!renderer) return MENU_QUIT;
 
-    if (TTF_Init() == -1) {
-        std::cerr << "TTF_Init failed: " << TTF_GetError() << std::endl;
-        return MENU_QUIT;
-    }
-    TTF_Font* font = TTF_OpenFont("assets/fonts/mohave-semibold.otf", 30);
-    if (!font) {
-        std::cerr << "Could not load font: " << TTF_GetError() << std::endl;
-        TTF_Quit();
-        return MENU_QUIT;
-    }
-    TTF_Font* titleFont = TTF_OpenFont("assets/fonts/LEMONMILK-Medium.otf", 48);
+    std::shared_ptr<FontAtlas> font = app.getFont(BODY_FONT, 30);
+    if (!font) return MENU_QUIT;
+    std::shared_ptr<FontAtlas> titleFont = app.getFont(TITLE_FONT, 48);
 
     std::vector<std::string> options = {"Play vs AI", "PvP (2 Players)", "Tutorial", "Settings", "Quit"};
     int selected = 0;
@@ -233,17 +193,14 @@ MainMenuChoice showMainMenu(SDLFramework &app) {
         // Title
         if (titleFont) {
             // Title shadow
-            drawTextCentered(renderer, titleFont, "SIGMA STRIKERS",
-                             w / 2 + 2, 82, {0, 0, 0, 200});
+            titleFont->drawCentered("SIGMA STRIKERS", w / 2 + 2, 82, {0, 0, 0, 200});
             // Title
             int pulseAlpha = 200 + (int)(55 * std::sin(animTimer * 2.0f));
-            drawTextCentered(renderer, titleFont, "SIGMA STRIKERS",
-                             w / 2, 80, {255, 215, 0, (Uint8)pulseAlpha});
+            titleFont->drawCentered("SIGMA STRIKERS", w / 2, 80, {255, 215, 0, (Uint8)pulseAlpha});
         }
 
         // Subtitle
-        drawTextCentered(renderer, font, "Hockey Action Game",
-                         w / 2, 130, {150, 150, 180, 255});
+        font->drawCentered("Hockey Action Game", w / 2, 130, {150, 150, 180, 255});
 
         // Menu items
         int itemH = 60;
@@ -277,30 +234,29 @@ MainMenuChoice showMainMenu(SDLFramework &app) {
                 SDL_RenderDrawRect(renderer, &outer);
 
                 // Arrow indicator
-                drawTextCentered(renderer, font, "> " + options[i] + " <",
-                                 w / 2, y + itemH / 2, {255, 255, 255, 255});
+                font->drawCentered("> " + options[i] + " <",
+                                   w / 2, y + itemH / 2, {255, 255, 255, 255});
             } else {
                 SDL_SetRenderDrawColor(renderer, 30, 30, 50, 200);
                 SDL_RenderFillRect(renderer, &rect);
                 SDL_SetRenderDrawColor(renderer, 60, 60, 80, 255);
                 SDL_RenderDrawRect(renderer, &rect);
 
-                drawText(renderer, font, options[i], rect,
-                         SDL_Color{180, 180, 200, 255});
+                font->drawInRect(options[i], rect, SDL_Color{180, 180, 200, 255});
             }
         }
 
         // Bottom instructions
-        drawTextCentered(renderer, font, "Arrow Keys + Enter to select",
-                         w / 2, h - 30, {100, 100, 130, 255});
+        font->drawCentered("Arrow Keys + Enter to select",
+                           w / 2, h - 30, {100, 100, 130, 255});
 
+        flushText(font.get(), titleFont.get());
+        // Upload whatever the loader has finished
+        app.getAssets().update();
         SDL_RenderPresent(renderer);
         SDL_Delay(16);
     }
 
-    if (titleFont && titleFont != font) TTF_CloseFont(titleFont);
-    TTF_CloseFont(font);
-
     // Map selected index to MainMenuChoice
     switch (selected) {
         case 0: return MENU_PLAY;
@@ -317,13 +273,9 @@ MainMenuChoice showMainMenu(SDLFramework &app) {
 void showTutorial(SDLFramework &app) {
     SDL_Renderer* renderer = app.getRenderer();
     if (!renderer) return;
-    if (TTF_Init() == -1) return;
-    TTF_Font* font = TTF_OpenFont("assets/fonts/mohave-semibold.otf", 22);
-    if (!font) {
-        TTF_Quit();
-        return;
-    }
-    TTF_Font* titleFont = TTF_OpenFont("assets/fonts/LEMONMILK-Medium.otf", 36);
+    std::shared_ptr<FontAtlas> font = app.getFont(BODY_FONT, 22);
+    if (!font) return;
+    std::shared_ptr<FontAtlas> titleFont = app.getFont(TITLE_FONT, 36);
 
     SDL_Event e;
     bool running = true;
@@ -339,22 +291,22 @@ void showTutorial(SDLFramework &app) {
         SDL_RenderClear(renderer);
 
         if (titleFont) {
-            drawTextCentered(renderer, titleFont, "HOW TO PLAY", w / 2, 50, {255, 215, 0, 255});
+            titleFont->drawCentered("HOW TO PLAY", w / 2, 50, {255, 215, 0, 255});
         }
 
         std::vector<std::string> lines = {
             "",
             "=== TEAM 1 (Blue - Left Side) ===",
             "  W/A/S/D  -  Move active player",
-            "  E        -  Swap between your 2 players",
+            "  E        -  Swap to your next player",
             "",
             "=== TEAM 2 (Red - Right Side) ===",
             "  Arrow Keys  -  Move active player",
-            "  Right Shift -  Swap between your 2 players",
+            "  Right Shift -  Swap to your next player",
             "",
             "=== GAMEPLAY ===",
             "  Push the puck into the opponent's goal to score!",
-            "  Your inactive player is controlled by AI.",
+            "  Your inactive players are controlled by AI.",
             "  The game ends when the timer runs out.",
             "",
             "  ESC  -  Quit / Return to menu",
@@ -374,16 +326,15 @@ void showTutorial(SDLFramework &app) {
             }
 
             SDL_Rect r = {40, y, w - 80, 28};
-            drawText(renderer, font, ln, r, col);
+            font->drawInRect(ln, r, col);
             y += 30;
         }
 
+        flushText(font.get(), titleFont.get());
+        app.getAssets().update();
         SDL_RenderPresent(renderer);
         SDL_Delay(16);
     }
-
-    if (titleFont) TTF_CloseFont(titleFont);
-    TTF_CloseFont(font);
 }
 
 // =============================================================================
@@ -393,10 +344,9 @@ void showSettingsMenu(SDLFramework &app) {
     SDL_Renderer* renderer = app.getRenderer();
     if (!renderer) return;
 
-    if (TTF_Init() == -1) return;
-    TTF_Font* font = TTF_OpenFont("assets/fonts/mohave-semibold.otf", 24);
+    std::shared_ptr<FontAtlas> font = app.getFont(BODY_FONT, 24);
     if (!font) return;
-    TTF_Font* titleFont = TTF_OpenFont("assets/fonts/LEMONMILK-Medium.otf", 36);
+    std::shared_ptr<FontAtlas> titleFont = app.getFont(TITLE_FONT, 36);
 
     // Settings options
     struct SettingItem {
@@ -408,6 +358,9 @@ void showSettingsMenu(SDLFramework &app) {
     std::vector<SettingItem> settings = {
         {"Match Duration", {"1 min", "2 min", "3 min", "5 min"}, 1},
         {"Resolution", {"800x600", "1024x768", "1280x720", "1366x768", "1920x1080"}, 1},
+        {"Team Size", {"2v2", "3v3", "5v5", "11v11"}, 0},
+        {"Display", {"Windowed", "Fullscreen"}, app.isFullscreen() ? 1 : 0},
+        {"AI Difficulty", {"Normal", "Hard", "Expert"}, gSettings.aiLevel},
         {"Back", {}, 0}
     };
 
@@ -418,6 +371,18 @@ void showSettingsMenu(SDLFramework &app) {
     else if (durSec == 180) settings[0].currentIndex = 2;
     else settings[0].currentIndex = 3;
 
+    // Sync current team size
+    int sizeValues[] = {2, 3, 5, 11};
+    for (int i = 0; i < 4; ++i) {
+        if (gSettings.playersPerTeam == sizeValues[i]) settings[2].currentIndex = i;
+    }
+
+    // Sync current resolution
+    std::string curRes = std::to_string(app.getWidth()) + "x" + std::to_string(app.getHeight());
+    for (size_t i = 0; i < settings[1].values.size(); ++i) {
+        if (settings[1].values[i] == curRes) settings[1].currentIndex = (int)i;
+    }
+
     int selected = 0;
     bool running = true;
     SDL_Event e;
@@ -458,12 +423,9 @@ void showSettingsMenu(SDLFramework &app) {
                             };
                             auto &res = resOpts[settings[1].currentIndex];
                             app.setResolution(res.first, res.second);
-                            // Reopen font after renderer change
-                            TTF_CloseFont(font);
-                            if (titleFont) TTF_CloseFont(titleFont);
-                            font = TTF_OpenFont("assets/fonts/mohave-semibold.otf", 24);
-                            titleFont = TTF_OpenFont("assets/fonts/LEMONMILK-Medium.otf", 36);
-                            if (!font) { running = false; break; }
+                        }
+                        if (settings[selected].label == "Display") {
+                            app.setFullscreen(settings[3].currentIndex == 1);
                         }
                         break;
                     case SDLK_ESCAPE:
@@ -477,6 +439,8 @@ void showSettingsMenu(SDLFramework &app) {
         // Apply settings changes live
         int durValues[] = {60, 120, 180, 300};
         gSettings.matchDuration = durValues[settings[0].currentIndex];
+        gSettings.playersPerTeam = sizeValues[settings[2].currentIndex];
+        gSettings.aiLevel = settings[4].currentIndex;
 
         int w = app.getWidth();
         int h = app.getHeight();
@@ -486,7 +450,7 @@ void showSettingsMenu(SDLFramework &app) {
 
         // Title
         if (titleFont) {
-            drawTextCentered(renderer, titleFont, "SETTINGS", w / 2, 60, {255, 215, 0, 255});
+            titleFont->drawCentered("SETTINGS", w / 2, 60, {255, 215, 0, 255});
         }
 
         int itemH = 55;
@@ -516,38 +480,71 @@ void showSettingsMenu(SDLFramework &app) {
 
             if (settings[i].values.empty()) {
                 // Simple button (Back)
-                drawText(renderer, font, settings[i].label, rect, labelCol);
+                font->drawInRect(settings[i].label, rect, labelCol);
             } else {
                 // Label on left
-                SDL_Rect labelRect = {x + 15, y, itemW / 2, itemH};
-                // Use left-aligned draw
-                SDL_Surface* surf = TTF_RenderText_Blended(font, settings[i].label.c_str(), labelCol);
-                if (surf) {
-                    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                    if (tex) {
-                        SDL_Rect dst = {x + 15, y + (itemH - surf->h) / 2, surf->w, surf->h};
-                        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                        SDL_DestroyTexture(tex);
-                    }
-                    SDL_FreeSurface(surf);
-                }
+                font->draw(settings[i].label, x + 15, y + (itemH - font->getLineHeight()) / 2, labelCol);
 
                 // Value on right with arrows
                 std::string valText = "< " + settings[i].values[settings[i].currentIndex] + " >";
                 SDL_Color valCol = ((int)i == selected) ? SDL_Color{255, 215, 0, 255} : SDL_Color{140, 140, 160, 255};
                 SDL_Rect valRect = {x + itemW / 2, y, itemW / 2 - 15, itemH};
-                drawText(renderer, font, valText, valRect, valCol);
+                font->drawInRect(valText, valRect, valCol);
             }
         }
 
         // Instructions
-        drawTextCentered(renderer, font, "UP/DOWN to select, LEFT/RIGHT to change, ENTER to apply, ESC to go back",
-                         w / 2, h - 30, {100, 100, 130, 255});
+        font->drawCentered("UP/DOWN to select, LEFT/RIGHT to change, ENTER to apply, ESC to go back",
+                           w / 2, h - 30, {100, 100, 130, 255});
 
+        flushText(font.get(), titleFont.get());
+        app.getAssets().update();
         SDL_RenderPresent(renderer);
         SDL_Delay(16);
     }
+}
 
-    if (titleFont) TTF_CloseFont(titleFont);
-    if (font) TTF_CloseFont(font);
+// =============================================================================
+// Loading Screen
+// =============================================================================
+bool showLoadingScreen(SDLFramework &app) {
+    SDL_Renderer* renderer = app.getRenderer();
+    if (!renderer) return false;
+
+    AssetManager &assets = app.getAssets();
+    std::shared_ptr<FontAtlas> font = app.getFont(BODY_FONT, 24);
+    SDL_Event e;
+
+    while (!assets.isIdle()) {
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_QUIT) return false;
+        }
+
+        int w = app.getWidth();
+        int h = app.getHeight();
+
+        SDL_SetRenderDrawColor(renderer, 15, 15, 35, 255);
+        SDL_RenderClear(renderer);
+
+        if (font) {
+            font->drawCentered("LOADING", w / 2, h / 2 - 40, {200, 200, 220, 255});
+        }
+
+        // Progress bar
+        int barW = w / 2;
+        int barH = 16;
+        SDL_Rect bar = {w / 2 - barW / 2, h / 2 - barH / 2, barW, barH};
+        SDL_Rect done = bar;
+        done.w = (int)(barW * assets.getProgress());
+        SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+        SDL_RenderFillRect(renderer, &done);
+        SDL_SetRenderDrawColor(renderer, 100, 100, 130, 255);
+        SDL_RenderDrawRect(renderer, &bar);
+
+        flushText(font.get(), nullptr);
+        // Nothing else to do this frame, so upload for longer than a menu does
+        assets.update(12.0);
+        SDL_RenderPresent(renderer);
+    }
+    return true;
 }
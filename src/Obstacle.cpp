@@ -1,98 +1,70 @@
 #include "../include/Obstacle.h"
 #include "../include/Field.h"
-#include "../include/Ball.h"
-#include "../include/Team.h" // for Player definition
 
 #include <algorithm>
 #include <cmath>
 
-static float clampVal(float v, float lo, float hi) {
-    if (v < lo) return lo;
-    if (v > hi) return hi;
-    return v;
-}
-
-void Obstacle::render(SDL_Renderer *renderer, const Field &field,
-                      int screenW, int screenH) const {
-    SDL_Rect vp = field.getViewport(screenW, screenH);
-    float sx = (float)vp.w / field.getWidth();
-    float sy = (float)vp.h / field.getHeight();
-
-    // position of top-left corner in screen coords
-    float screenX = vp.x + (pos.x - width / 2.0f) * sx;
-    float screenY = vp.y + (pos.y - height / 2.0f) * sy;
-    SDL_Rect rect = { (int)screenX, (int)screenY,
-                      (int)(width * sx), (int)(height * sy) };
+Obstacle::Obstacle(const Vector &centre, float w, float h)
+    : shape(ObstacleShape::RECT), pos(centre), width(w), height(h) {}
 
-    SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-    SDL_RenderFillRect(renderer, &rect);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &rect);
+Obstacle Obstacle::circle(const Vector &centre, float radius) {
+    Obstacle obs(centre, radius * 2.0f, radius * 2.0f);
+    obs.shape = ObstacleShape::CIRCLE;
+    return obs;
 }
 
-bool Obstacle::handleBallCollision(Ball &ball) const {
-    // compute nearest point on rectangle to ball centre
-    float halfw = width / 2.0f;
-    float halfh = height / 2.0f;
-    float minx = pos.x - halfw;
-    float maxx = pos.x + halfw;
-    float miny = pos.y - halfh;
-    float maxy = pos.y + halfh;
-
-    float cx = clampVal(ball.pos.x, minx, maxx);
-    float cy = clampVal(ball.pos.y, miny, maxy);
-
-    float dx = ball.pos.x - cx;
-    float dy = ball.pos.y - cy;
-    float dist2 = dx*dx + dy*dy;
-    float r2 = ball.radius * ball.radius;
-    if (dist2 < r2) {
-        float dist = std::sqrt(dist2);
-        if (dist < 1e-6f) {
-            // centre inside obstacle, choose arbitrary normal
-            dy = 1.0f;
-            dist = 1.0f;
-        }
-        Vector norm = { dx / dist, dy / dist };
-        // push ball out of obstacle
-        ball.pos.x = cx + norm.x * ball.radius;
-        ball.pos.y = cy + norm.y * ball.radius;
-
-        // reflect velocity
-        float vdot = ball.vel.x * norm.x + ball.vel.y * norm.y;
-        if (vdot < 0.0f) {
-            float e = 0.75f; // restitution
-            ball.vel.x -= (1.0f + e) * vdot * norm.x;
-            ball.vel.y -= (1.0f + e) * vdot * norm.y;
-        }
-        return true;
+Obstacle Obstacle::polygon(const std::vector<Vector> &pts) {
+    float minx = pts[0].x, maxx = pts[0].x;
+    float miny = pts[0].y, maxy = pts[0].y;
+    for (const Vector &p : pts) {
+        minx = std::min(minx, p.x);
+        maxx = std::max(maxx, p.x);
+        miny = std::min(miny, p.y);
+        maxy = std::max(maxy, p.y);
     }
-    return false;
+    Obstacle obs(Vector((minx + maxx) / 2.0f, (miny + maxy) / 2.0f),
+                 maxx - minx, maxy - miny);
+    obs.shape = ObstacleShape::POLYGON;
+    obs.points = pts;
+    return obs;
 }
 
-void Obstacle::resolvePlayerCollision(Player &player) const {
-    float halfw = width / 2.0f;
-    float halfh = height / 2.0f;
-    float minx = pos.x - halfw;
-    float maxx = pos.x + halfw;
-    float miny = pos.y - halfh;
-    float maxy = pos.y + halfh;
-
-    float cx = clampVal(player.pos.x, minx, maxx);
-    float cy = clampVal(player.pos.y, miny, maxy);
-
-    float dx = player.pos.x - cx;
-    float dy = player.pos.y - cy;
-    float dist2 = dx*dx + dy*dy;
-    float r2 = player.radius * player.radius;
-    if (dist2 < r2) {
-        float dist = std::sqrt(dist2);
-        if (dist < 1e-6f) {
-            dy = 1.0f;
-            dist = 1.0f;
+float Obstacle::signedDistance(const Vector &p) const {
+    switch (shape) {
+    case ObstacleShape::RECT: {
+        // distance outside along each axis (negative = inside that slab)
+        float dx = std::abs(p.x - pos.x) - width / 2.0f;
+        float dy = std::abs(p.y - pos.y) - height / 2.0f;
+        float ox = std::max(dx, 0.0f);
+        float oy = std::max(dy, 0.0f);
+        float outside = std::sqrt(ox * ox + oy * oy);
+        float inside = std::min(std::max(dx, dy), 0.0f);
+        return outside + inside;
+    }
+    case ObstacleShape::CIRCLE:
+        return (p - pos).length() - getRadius();
+    case ObstacleShape::POLYGON: {
+        // Closest edge gives the distance; crossing count gives the sign
+        float best2 = 1e30f;
+        bool inside = false;
+        size_t n = points.size();
+        for (size_t i = 0, j = n - 1; i < n; j = i++) {
+            const Vector &a = points[j];
+            const Vector &b = points[i];
+            Vector ab = b - a;
+            Vector ap = p - a;
+            float t = ab.dot(ap) / std::max(1e-12f, ab.dot(ab));
+            t = std::min(std::max(t, 0.0f), 1.0f);
+            Vector d = ap - ab * t;
+            best2 = std::min(best2, d.dot(d));
+            if ((a.y > p.y) != (b.y > p.y) &&
+                p.x < a.x + (p.y - a.y) * ab.x / ab.y) {
+                inside = !inside;
+            }
         }
-        float overlap = player.radius - dist;
-        player.pos.x += (dx / dist) * overlap;
-        player.pos.y += (dy / dist) * overlap;
+        float dist = std::sqrt(best2);
+        return inside ? -dist : dist;
+    }
     }
+    return 0.0f;
 }
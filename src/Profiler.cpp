@@ -0,0 +1,152 @@
+#include "../include/Profiler.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+static const char *ZONE_NAMES[(int)ProfileZone::COUNT] = {
+    "input", "ai", "collision", "field render", "team render", "submit", "hud render", "present"
+};
+
+// Small per-thread id for the trace, in order of first use
+static int threadIndex() {
+    static std::atomic<int> next(0);
+    thread_local int index = next.fetch_add(1);
+    return index;
+}
+
+Profiler &Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+: enabled(false), epoch(now()), frameThread(-1), frameStart(0), frames(HISTORY), frameHead(0),
+  frameCount(0), events(MAX_EVENTS), eventHead(0), eventCount(0) {
+    for (std::atomic<uint64_t> &z : current) z.store(0);
+    for (std::atomic<uint64_t> &z : currentBackground) z.store(0);
+    frameStart = epoch;
+}
+
+uint64_t Profiler::now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char *Profiler::zoneName(ProfileZone zone) {
+    int i = (int)zone;
+    return i >= 0 && i < ZONES ? ZONE_NAMES[i] : "?";
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+void Profiler::record(ProfileZone zone, uint64_t start, uint64_t end) {
+    const int thread = threadIndex();
+    const int owner = frameThread.load(std::memory_order_relaxed);
+    std::atomic<uint64_t> *totals = (owner < 0 || owner == thread) ? current : currentBackground;
+    totals[(int)zone].fetch_add(end - start, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(eventMutex);
+    events[eventHead] = Event{start, end, zone, thread};
+    eventHead = (eventHead + 1) % MAX_EVENTS;
+    if (eventCount < (size_t)MAX_EVENTS) eventCount++;
+}
+
+void Profiler::endFrame() {
+    uint64_t t = now();
+    frameThread.store(threadIndex(), std::memory_order_relaxed);
+    if (!isEnabled()) {
+        // Nothing recorded; the next frame starts here
+        for (std::atomic<uint64_t> &z : current) z.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t> &z : currentBackground) z.store(0, std::memory_order_relaxed);
+        frameStart = t;
+        return;
+    }
+    Frame &f = frames[frameHead];
+    f.start = frameStart;
+    f.end = t;
+    for (int z = 0; z < ZONES; ++z) {
+        f.zones[z] = current[z].exchange(0, std::memory_order_relaxed);
+        f.background[z] = currentBackground[z].exchange(0, std::memory_order_relaxed);
+    }
+    frameHead = (frameHead + 1) % HISTORY;
+    if (frameCount < HISTORY) frameCount++;
+    frameStart = t;
+}
+
+void Profiler::clear() {
+    frameHead = 0;
+    frameCount = 0;
+    std::lock_guard<std::mutex> lock(eventMutex);
+    eventHead = 0;
+    eventCount = 0;
+}
+
+const Profiler::Frame &Profiler::frameAt(int framesAgo) const {
+    return frames[((frameHead - 1 - framesAgo) % HISTORY + HISTORY) % HISTORY];
+}
+
+float Profiler::getFrameMs(int framesAgo) const {
+    if (framesAgo < 0 || framesAgo >= frameCount) return 0.0f;
+    const Frame &f = frameAt(framesAgo);
+    return (f.end - f.start) / 1e6f;
+}
+
+float Profiler::getZoneMs(int framesAgo, ProfileZone zone) const {
+    if (framesAgo < 0 || framesAgo >= frameCount) return 0.0f;
+    return frameAt(framesAgo).zones[(int)zone] / 1e6f;
+}
+
+float Profiler::getBackgroundMs(int framesAgo, ProfileZone zone) const {
+    if (framesAgo < 0 || framesAgo >= frameCount) return 0.0f;
+    return frameAt(framesAgo).background[(int)zone] / 1e6f;
+}
+
+// ============================================================================
+// Dumps
+// ============================================================================
+bool Profiler::writeCsv(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Could not write profile " << path << std::endl;
+        return false;
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "frame,start_ms,frame_ms";
+    for (int z = 0; z < ZONES; ++z) out << ',' << ZONE_NAMES[z];
+    for (int z = 0; z < ZONES; ++z) out << ",background " << ZONE_NAMES[z];
+    out << '\n';
+    // Oldest first
+    for (int ago = frameCount - 1; ago >= 0; --ago) {
+        const Frame &f = frameAt(ago);
+        out << (frameCount - 1 - ago) << ',' << (f.start - epoch) / 1e6 << ','
+            << (f.end - f.start) / 1e6;
+        for (int z = 0; z < ZONES; ++z) out << ',' << f.zones[z] / 1e6;
+        for (int z = 0; z < ZONES; ++z) out << ',' << f.background[z] / 1e6;
+        out << '\n';
+    }
+    return (bool)out;
+}
+
+bool Profiler::writeChromeTrace(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Could not write trace " << path << std::endl;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(eventMutex);
+    out << std::fixed << std::setprecision(3);
+    // Complete ("X") events in microseconds since the profiler started
+    out << "{\"traceEvents\":[\n";
+    size_t first = (eventHead + MAX_EVENTS - eventCount) % MAX_EVENTS;
+    for (size_t i = 0; i < eventCount; ++i) {
+        const Event &e = events[(first + i) % MAX_EVENTS];
+        out << (i ? ",\n" : "") << "{\"name\":\"" << zoneName(e.zone)
+            << "\",\"cat\":\"sigma\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+            << ",\"ts\":" << (e.start - epoch) / 1e3 << ",\"dur\":" << (e.end - e.start) / 1e3
+            << "}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return (bool)out;
+}
@@ -0,0 +1,126 @@
+#include "../include/ProfilerOverlay.h"
+#include "../include/Profiler.h"
+#include "../include/SDLFramework.h"
+#include "../include/ShapeBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static const int ZONES = (int)ProfileZone::COUNT;
+static const SDL_Color ZONE_COLORS[ZONES] = {
+    {200, 200, 200, 255},   // input
+    {255, 170, 0, 255},     // ai
+    {255, 80, 80, 255},     // collision
+    {60, 200, 90, 255},     // field render
+    {80, 140, 255, 255},    // team render
+    {200, 100, 255, 255},   // submit
+    {255, 230, 90, 255},    // hud render
+    {90, 220, 220, 255},    // present
+};
+
+static const float PX_PER_MS = 3.0f;    // 100 px graph = 33.3 ms
+static const int GRAPH_H = 100;
+static const int BACKGROUND_H = 50;     // row for the other threads, same scale
+static const int LEGEND_FRAMES = 60;    // about a second at 60 fps
+
+ProfilerOverlay::ProfilerOverlay() : visible(false) {}
+
+bool ProfilerOverlay::init(SDLFramework &app) {
+    font = app.getFont("assets/fonts/mohave-semibold.otf", 16);
+    return font != nullptr;
+}
+
+void ProfilerOverlay::render(ShapeBatch &batch, int screenW, int screenH) const {
+    if (!visible) return;
+    const Profiler &prof = Profiler::instance();
+    const int graphW = Profiler::HISTORY;
+    const int lineH = font ? std::max(14, font->getLineHeight()) : 14;
+    const int panelW = graphW + 60;
+    const int panelH = GRAPH_H + BACKGROUND_H + 40 + (ZONES + 1) * lineH;
+    const int px = screenW - panelW - 10;
+    const int py = std::min(60, std::max(0, screenH - panelH));
+
+    batch.fillRect(SDL_FRect{(float)px, (float)py, (float)panelW, (float)panelH},
+                   SDL_Color{0, 0, 0, 180});
+
+    // Bars, newest on the right; grey is frame time outside the zones
+    const float gx = (float)(px + 10);
+    const float base = (float)(py + 10 + GRAPH_H);
+    const int n = prof.getFrameCount();
+    for (int ago = 0; ago < n; ++ago) {
+        float x = gx + graphW - 1 - ago;
+        float frameH = std::min((float)GRAPH_H, prof.getFrameMs(ago) * PX_PER_MS);
+        batch.fillRect(SDL_FRect{x, base - frameH, 1.0f, frameH}, SDL_Color{70, 70, 80, 255});
+        float y = base;
+        for (int z = 0; z < ZONES; ++z) {
+            float h = prof.getZoneMs(ago, (ProfileZone)z) * PX_PER_MS;
+            h = std::min(h, y - (base - GRAPH_H));
+            if (h <= 0.0f) continue;
+            y -= h;
+            batch.fillRect(SDL_FRect{x, y, 1.0f, h}, ZONE_COLORS[z]);
+        }
+    }
+    // 60 and 30 fps budgets
+    for (float ms : {1000.0f / 60.0f, 1000.0f / 30.0f}) {
+        float y = std::floor(base - ms * PX_PER_MS);
+        batch.line(gx, y, gx + graphW - 1, y, 1.0f, SDL_Color{255, 255, 255, 90});
+    }
+
+    // Zones timed on other threads (the simulation) while each frame ran,
+    // in a row of their own: they overlap the frame instead of adding to it
+    const float backgroundBase = base + 10 + BACKGROUND_H;
+    batch.fillRect(SDL_FRect{gx, backgroundBase - BACKGROUND_H, (float)graphW, (float)BACKGROUND_H},
+                   SDL_Color{40, 40, 48, 255});
+    for (int ago = 0; ago < n; ++ago) {
+        float x = gx + graphW - 1 - ago;
+        float y = backgroundBase;
+        for (int z = 0; z < ZONES; ++z) {
+            float h = prof.getBackgroundMs(ago, (ProfileZone)z) * PX_PER_MS;
+            h = std::min(h, y - (backgroundBase - BACKGROUND_H));
+            if (h <= 0.0f) continue;
+            y -= h;
+            batch.fillRect(SDL_FRect{x, y, 1.0f, h}, ZONE_COLORS[z]);
+        }
+    }
+    batch.flush();
+    if (!font) return;
+
+    // Legend: average / worst over the last LEGEND_FRAMES frames; zones
+    // timed on another thread are marked as such
+    const int frames = std::min(n, LEGEND_FRAMES);
+    char text[96];
+    int ty = (int)backgroundBase + 10;
+    float frameAvg = 0.0f, frameMax = 0.0f;
+    for (int ago = 0; ago < frames; ++ago) {
+        frameAvg += prof.getFrameMs(ago);
+        frameMax = std::max(frameMax, prof.getFrameMs(ago));
+    }
+    if (frames > 0) frameAvg /= frames;
+    if (Profiler::COMPILED_IN) {
+        std::snprintf(text, sizeof(text), "frame  %.2f ms avg  %.2f max", frameAvg, frameMax);
+    } else {
+        std::snprintf(text, sizeof(text), "profiling not compiled in (SIGMA_PROFILE)");
+    }
+    font->draw(text, px + 10, ty, SDL_Color{255, 255, 255, 255});
+    for (int z = 0; z < ZONES; ++z) {
+        ty += lineH;
+        float avg = 0.0f, worst = 0.0f;
+        bool background = false;
+        for (int ago = 0; ago < frames; ++ago) {
+            float bg = prof.getBackgroundMs(ago, (ProfileZone)z);
+            float ms = prof.getZoneMs(ago, (ProfileZone)z) + bg;
+            avg += ms;
+            worst = std::max(worst, ms);
+            background = background || bg > 0.0f;
+        }
+        if (frames > 0) avg /= frames;
+        batch.fillRect(SDL_FRect{(float)(px + 10), (float)(ty + lineH / 2 - 4), 8.0f, 8.0f},
+                       ZONE_COLORS[z]);
+        std::snprintf(text, sizeof(text), "%s  %.2f ms avg  %.2f max%s",
+                      Profiler::zoneName((ProfileZone)z), avg, worst,
+                      background ? "  (other thread)" : "");
+        font->draw(text, px + 24, ty, SDL_Color{220, 220, 220, 255});
+    }
+    batch.flush();
+    font->flush();
+}
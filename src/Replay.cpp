@@ -0,0 +1,358 @@
+#include "../include/Replay.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const char     REPLAY_MAGIC[4] = {'S', 'S', 'R', 'P'};
+static const uint16_t REPLAY_VERSION  = 3;
+
+// ============================================================================
+// Input packing
+// ============================================================================
+uint8_t packTeamInput(const TeamInput &in) {
+    uint8_t bits = 0;
+    if (in.up)    bits |= 1 << 0;
+    if (in.down)  bits |= 1 << 1;
+    if (in.left)  bits |= 1 << 2;
+    if (in.right) bits |= 1 << 3;
+    if (in.swap)  bits |= 1 << 4;
+    return bits;
+}
+
+TeamInput unpackTeamInput(uint8_t bits) {
+    TeamInput in;
+    in.up    = (bits & (1 << 0)) != 0;
+    in.down  = (bits & (1 << 1)) != 0;
+    in.left  = (bits & (1 << 2)) != 0;
+    in.right = (bits & (1 << 3)) != 0;
+    in.swap  = (bits & (1 << 4)) != 0;
+    return in;
+}
+
+// ============================================================================
+// Little-endian binary helpers
+// ============================================================================
+static void writeU8(std::ostream &out, uint8_t v) {
+    out.put((char)v);
+}
+
+static void writeU16(std::ostream &out, uint16_t v) {
+    writeU8(out, (uint8_t)(v & 0xFF));
+    writeU8(out, (uint8_t)(v >> 8));
+}
+
+static void writeU32(std::ostream &out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) writeU8(out, (uint8_t)(v >> (8 * i)));
+}
+
+static void writeF32(std::ostream &out, float f) {
+    uint32_t v;
+    std::memcpy(&v, &f, sizeof(v));
+    writeU32(out, v);
+}
+
+static void writeVarint(std::ostream &out, uint32_t v) {
+    while (v >= 0x80) {
+        writeU8(out, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    writeU8(out, (uint8_t)v);
+}
+
+static bool readU8(std::istream &in, uint8_t &v) {
+    char c;
+    if (!in.get(c)) return false;
+    v = (uint8_t)c;
+    return true;
+}
+
+static bool readU16(std::istream &in, uint16_t &v) {
+    uint8_t lo, hi;
+    if (!readU8(in, lo) || !readU8(in, hi)) return false;
+    v = (uint16_t)(lo | (hi << 8));
+    return true;
+}
+
+static bool readU32(std::istream &in, uint32_t &v) {
+    v = 0;
+    for (int i = 0; i < 4; ++i) {
+        uint8_t b;
+        if (!readU8(in, b)) return false;
+        v |= (uint32_t)b << (8 * i);
+    }
+    return true;
+}
+
+static bool readF32(std::istream &in, float &f) {
+    uint32_t v;
+    if (!readU32(in, v)) return false;
+    std::memcpy(&f, &v, sizeof(f));
+    return true;
+}
+
+static bool readVarint(std::istream &in, uint32_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t b;
+        if (!readU8(in, b)) return false;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Obstacles
+// ============================================================================
+static void writeObstacle(std::ostream &out, const Obstacle &obs) {
+    writeU8(out, (uint8_t)obs.getShape());
+    switch (obs.getShape()) {
+    case ObstacleShape::RECT:
+        writeF32(out, obs.getPos().x);
+        writeF32(out, obs.getPos().y);
+        writeF32(out, obs.getWidth());
+        writeF32(out, obs.getHeight());
+        break;
+    case ObstacleShape::CIRCLE:
+        writeF32(out, obs.getPos().x);
+        writeF32(out, obs.getPos().y);
+        writeF32(out, obs.getRadius());
+        break;
+    case ObstacleShape::POLYGON:
+        writeU16(out, (uint16_t)obs.getPoints().size());
+        for (const Vector &p : obs.getPoints()) {
+            writeF32(out, p.x);
+            writeF32(out, p.y);
+        }
+        break;
+    }
+}
+
+static bool readObstacle(std::istream &in, Obstacle &obs) {
+    uint8_t shape;
+    if (!readU8(in, shape)) return false;
+    switch ((ObstacleShape)shape) {
+    case ObstacleShape::RECT: {
+        float x, y, w, h;
+        if (!readF32(in, x) || !readF32(in, y) || !readF32(in, w) || !readF32(in, h)) return false;
+        obs = Obstacle(Vector(x, y), w, h);
+        return true;
+    }
+    case ObstacleShape::CIRCLE: {
+        float x, y, r;
+        if (!readF32(in, x) || !readF32(in, y) || !readF32(in, r)) return false;
+        obs = Obstacle::circle(Vector(x, y), r);
+        return true;
+    }
+    case ObstacleShape::POLYGON: {
+        uint16_t n;
+        if (!readU16(in, n) || n < 3) return false;
+        std::vector<Vector> pts(n);
+        for (Vector &p : pts) {
+            if (!readF32(in, p.x) || !readF32(in, p.y)) return false;
+        }
+        obs = Obstacle::polygon(pts);
+        return true;
+    }
+    }
+    return false;
+}
+
+// ============================================================================
+// Recorder
+// ============================================================================
+ReplayRecorder::ReplayRecorder() : stepCount(0) {
+    header.mode = MODE_VS_AI;
+    header.playersPerTeam = 2;
+    header.seed = 0;
+    header.matchDuration = 0.0f;
+    header.fieldWidth = 0.0f;
+    header.fieldHeight = 0.0f;
+}
+
+void ReplayRecorder::begin(const MatchSimulation &sim) {
+    const Field &field = sim.getField();
+    header.mode = sim.getMode();
+    header.playersPerTeam = sim.getPlayersPerTeam();
+    header.seed = sim.getSeed();
+    header.matchDuration = sim.getTimeRemaining();
+    header.fieldWidth = field.getWidth();
+    header.fieldHeight = field.getHeight();
+    header.obstacles = field.getObstacles();
+    runs.clear();
+    stepCount = 0;
+}
+
+void ReplayRecorder::recordStep(const MatchInputs &inputs) {
+    uint8_t a = packTeamInput(inputs.team1);
+    uint8_t b = packTeamInput(inputs.team2);
+    if (!runs.empty() && runs.back().team1 == a && runs.back().team2 == b) {
+        runs.back().steps++;
+    } else {
+        runs.push_back(ReplayRun{a, b, 1});
+    }
+    stepCount++;
+}
+
+bool ReplayRecorder::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open replay for writing: " << path << std::endl;
+        return false;
+    }
+
+    out.write(REPLAY_MAGIC, 4);
+    writeU16(out, REPLAY_VERSION);
+    writeU16(out, (uint16_t)(1.0f / MatchSimulation::FIXED_DT + 0.5f));
+    writeU8(out, (uint8_t)header.mode);
+    writeU8(out, (uint8_t)header.playersPerTeam);
+    writeU32(out, header.seed);
+    writeF32(out, header.matchDuration);
+    writeF32(out, header.fieldWidth);
+    writeF32(out, header.fieldHeight);
+
+    writeU16(out, (uint16_t)header.obstacles.size());
+    for (const Obstacle &obs : header.obstacles) {
+        writeObstacle(out, obs);
+    }
+
+    writeU32(out, (uint32_t)runs.size());
+    for (const ReplayRun &run : runs) {
+        writeU8(out, run.team1);
+        writeU8(out, run.team2);
+        writeVarint(out, run.steps);
+    }
+
+    if (!out) {
+        std::cerr << "Failed to write replay: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Player
+// ============================================================================
+ReplayPlayer::ReplayPlayer()
+    : stepCount(0), runIndex(0), stepInRun(0), stepIndex(0) {
+    header.mode = MODE_VS_AI;
+    header.playersPerTeam = 2;
+    header.seed = 0;
+    header.matchDuration = 0.0f;
+    header.fieldWidth = 0.0f;
+    header.fieldHeight = 0.0f;
+}
+
+bool ReplayPlayer::load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Failed to open replay: " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    if (!in.read(magic, 4) || std::memcmp(magic, REPLAY_MAGIC, 4) != 0) {
+        std::cerr << "Not a replay file: " << path << std::endl;
+        return false;
+    }
+
+    uint16_t version, tickRate;
+    uint8_t mode, playersPerTeam;
+    ReplayHeader h;
+    if (!readU16(in, version) || !readU16(in, tickRate) || !readU8(in, mode) ||
+        !readU8(in, playersPerTeam) || !readU32(in, h.seed) || !readF32(in, h.matchDuration) ||
+        !readF32(in, h.fieldWidth) || !readF32(in, h.fieldHeight)) {
+        std::cerr << "Truncated replay header: " << path << std::endl;
+        return false;
+    }
+    if (version != REPLAY_VERSION) {
+        std::cerr << "Unsupported replay version " << version << ": " << path << std::endl;
+        return false;
+    }
+    if (tickRate != (uint16_t)(1.0f / MatchSimulation::FIXED_DT + 0.5f)) {
+        std::cerr << "Replay recorded at " << tickRate << " Hz, simulation runs at "
+                  << (int)(1.0f / MatchSimulation::FIXED_DT + 0.5f) << " Hz" << std::endl;
+        return false;
+    }
+    if (mode > MODE_AI_VS_AI) {
+        std::cerr << "Invalid game mode in replay: " << path << std::endl;
+        return false;
+    }
+    h.mode = (GameMode)mode;
+    if (playersPerTeam < 1) {
+        std::cerr << "Invalid team size in replay: " << path << std::endl;
+        return false;
+    }
+    h.playersPerTeam = playersPerTeam;
+
+    uint16_t obstacleCount;
+    if (!readU16(in, obstacleCount)) return false;
+    for (uint16_t i = 0; i < obstacleCount; ++i) {
+        Obstacle obs;
+        if (!readObstacle(in, obs)) {
+            std::cerr << "Bad obstacle list: " << path << std::endl;
+            return false;
+        }
+        h.obstacles.push_back(obs);
+    }
+
+    uint32_t runCount;
+    if (!readU32(in, runCount)) return false;
+    std::vector<ReplayRun> r;
+    int total = 0;
+    for (uint32_t i = 0; i < runCount; ++i) {
+        ReplayRun run;
+        if (!readU8(in, run.team1) || !readU8(in, run.team2) || !readVarint(in, run.steps)) {
+            std::cerr << "Truncated input stream: " << path << std::endl;
+            return false;
+        }
+        r.push_back(run);
+        total += (int)run.steps;
+    }
+
+    header = h;
+    runs.swap(r);
+    stepCount = total;
+    rewind();
+    return true;
+}
+
+MatchSimulation ReplayPlayer::createSimulation() const {
+    Field field(header.fieldWidth, header.fieldHeight);
+    for (const Obstacle &obs : header.obstacles) {
+        field.addObstacle(obs);
+    }
+    return MatchSimulation(field, header.mode, header.matchDuration,
+                           header.playersPerTeam, header.seed);
+}
+
+void ReplayPlayer::rewind() {
+    runIndex = 0;
+    stepInRun = 0;
+    stepIndex = 0;
+}
+
+bool ReplayPlayer::nextInputs(MatchInputs &out) {
+    while (runIndex < runs.size() && stepInRun >= runs[runIndex].steps) {
+        runIndex++;
+        stepInRun = 0;
+    }
+    if (runIndex >= runs.size()) return false;
+
+    out.team1 = unpackTeamInput(runs[runIndex].team1);
+    out.team2 = unpackTeamInput(runs[runIndex].team2);
+    stepInRun++;
+    stepIndex++;
+    if (stepInRun >= runs[runIndex].steps) {
+        runIndex++;
+        stepInRun = 0;
+    }
+    return true;
+}
+
+void ReplayPlayer::runToEnd(MatchSimulation &sim) {
+    MatchInputs inputs;
+    while (nextInputs(inputs)) {
+        sim.step(MatchSimulation::FIXED_DT, inputs);
+    }
+}
@@ -0,0 +1,183 @@
+#include "../include/RolloutPlanner.h"
+#include "../include/Ball.h"
+#include "../include/Field.h"
+#include "../include/InfluenceMap.h"
+#include "../include/PlayerStore.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// Step length the ball is traced with (MatchSimulation::FIXED_DT)
+static const float STEP_DT = 1.0f / 120.0f;
+
+// Execution noise of a kick: direction (radians either way) and speed
+// (fraction either way)
+static const float KICK_ANGLE_NOISE = 0.06f;
+static const float KICK_SPEED_NOISE = 0.1f;
+
+// Players reach a loose ball at this fraction of their top speed, after
+// a reaction delay (seconds).  Our side knows the plan, so reacts sooner.
+static const float RUN_SPEED_MIN = 0.8f;
+static const float RUN_SPEED_MAX = 1.1f;
+static const float OUR_DELAY_MAX = 0.15f;
+static const float THEIR_DELAY_MIN = 0.1f;
+static const float THEIR_DELAY_MAX = 0.3f;
+
+// The carrier keeps the ball at this fraction of top speed
+static const float DRIBBLE_SPEED_MIN = 0.6f;
+static const float DRIBBLE_SPEED_MAX = 0.9f;
+static const float DRIBBLE_HORIZON = 0.5f;
+
+// Goal angle (radians) at which a spot counts as fully dangerous
+static const float SHOT_SCALE = 0.6f;
+
+// Exploration weight of UCB1; outcomes are in [-1, 1]
+static const float EXPLORATION = 0.5f;
+
+float RolloutPlanner::random(float lo, float hi) {
+    // xorshift32: cheap, and the same sequence on every platform
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return lo + (hi - lo) * (rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+// ============================================================================
+// Choosing
+// ============================================================================
+int RolloutPlanner::choose(const Ball &ball, const Field &field, const InfluenceMap &influence,
+                           const PlayerStore &team, int active, const PlayerStore &opponents,
+                           bool isLeftSide, float reaction, float budget, int maxRollouts) {
+    using Clock = std::chrono::steady_clock;
+    const int n = (int)actions.size();
+    sums.assign(n, 0.0f);
+    counts.assign(n, 0);
+    rollouts = 0;
+    if (n <= 1) return n - 1;
+
+    const Situation s{&ball, &field, &influence, &team, &opponents, active, isLeftSide, reaction};
+    const Clock::time_point deadline =
+        Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(budget));
+
+    // Every action once, then UCB1 until the time or the cap runs out
+    while (rollouts < std::max(maxRollouts, n)) {
+        int pick = rollouts;
+        if (rollouts >= n) {
+            float logN = std::log((float)rollouts);
+            float bestBound = -1e30f;
+            for (int a = 0; a < n; ++a) {
+                float bound = sums[a] / counts[a] + EXPLORATION * std::sqrt(logN / counts[a]);
+                if (bound > bestBound) {
+                    bestBound = bound;
+                    pick = a;
+                }
+            }
+        }
+        sums[pick] += rollout(s, actions[pick]);
+        counts[pick]++;
+        rollouts++;
+        if (rollouts >= n && Clock::now() >= deadline) break;
+    }
+
+    // Best average; the first action added wins ties
+    int best = 0;
+    for (int a = 1; a < n; ++a) {
+        if (getValue(a) > getValue(best)) best = a;
+    }
+    return best;
+}
+
+// ============================================================================
+// Rollouts
+// ============================================================================
+float RolloutPlanner::rollout(const Situation &s, const PlanAction &action) {
+    return action.kind == PlanAction::DRIBBLE ? rolloutDribble(s, action)
+                                              : rolloutKick(s, action);
+}
+
+float RolloutPlanner::possessionValue(const Situation &s, const Vector &p, bool ours) const {
+    if (ours) return 0.3f + 0.4f * std::min(1.0f, s.influence->shotValue(p) / SHOT_SCALE);
+    return -(0.3f + 0.4f * std::min(1.0f, s.influence->threat(p) / SHOT_SCALE));
+}
+
+float RolloutPlanner::rolloutKick(const Situation &s, const PlanAction &action) {
+    // The kick MatchSimulation::applyAIKicks makes, a little off
+    Ball ball = *s.ball;
+    Vector aim = action.target - ball.pos;
+    float dist = aim.length();
+    if (dist < 0.001f) return 0.0f;
+    float speed = (action.kind == PlanAction::SHOOT)
+                      ? std::min(30.0f, std::max(18.0f, dist * 1.5f))
+                      : std::min(25.0f, std::max(12.0f, dist * 1.2f));
+    float angle = std::atan2(aim.y, aim.x) + random(-KICK_ANGLE_NOISE, KICK_ANGLE_NOISE);
+    speed *= random(1.0f - KICK_SPEED_NOISE, 1.0f + KICK_SPEED_NOISE);
+    ball.vel = Vector(std::cos(angle), std::sin(angle)) * speed;
+    predictor.predict(ball, *s.field, STEP_DT);
+
+    // Everyone but the kicker races for it
+    float first = HORIZON;
+    Vector where;
+    bool ours = false;
+    for (int side = 0; side < 2; ++side) {
+        const PlayerStore &players = side == 0 ? *s.team : *s.opponents;
+        for (int i = 0; i < players.size(); ++i) {
+            if (side == 0 && i == s.active) continue;
+            float run = players.speed[i] * s.reaction * random(RUN_SPEED_MIN, RUN_SPEED_MAX);
+            float delay = side == 0 ? random(0.0f, OUR_DELAY_MAX)
+                                    : random(THEIR_DELAY_MIN, THEIR_DELAY_MAX);
+            // Starting late is the same as reaching that much less far
+            float reach = players.radius[i] + ball.radius - run * delay;
+            float t;
+            Vector p;
+            if (predictor.intercept(players.getPos(i), run, reach, t, p) && t < first) {
+                first = t;
+                where = p;
+                ours = (side == 0);
+            }
+        }
+    }
+    if (first < HORIZON) return possessionValue(s, where, ours);
+
+    int goal = predictor.getGoal();
+    if (goal != 0) return ((goal == 2) == s.isLeftSide) ? 1.0f : -1.0f;
+    return 0.0f;
+}
+
+float RolloutPlanner::rolloutDribble(const Situation &s, const PlanAction &action) {
+    // The carrier runs at the target with the ball and stops at the edge
+    // of the pitch; each opponent closes in after a reaction delay
+    const PlayerStore &team = *s.team;
+    const PlayerStore &opponents = *s.opponents;
+    const Field &field = *s.field;
+    const Vector start = team.getPos(s.active);
+    const Vector dir = (action.target - start).normalized();
+    const float carry = team.speed[s.active] * s.reaction *
+                        random(DRIBBLE_SPEED_MIN, DRIBBLE_SPEED_MAX);
+    const float r = team.radius[s.active];
+    auto carrierAt = [&](float t) {
+        Vector c = start + dir * (carry * t);
+        c.x = std::min(std::max(c.x, r), field.getWidth() - r);
+        c.y = std::min(std::max(c.y, r), field.getHeight() - r);
+        return c;
+    };
+
+    float lost = DRIBBLE_HORIZON;
+    for (int i = 0; i < opponents.size(); ++i) {
+        const Vector from = opponents.getPos(i);
+        const float run = opponents.speed[i] * s.reaction * random(RUN_SPEED_MIN, RUN_SPEED_MAX);
+        const float delay = random(THEIR_DELAY_MIN, THEIR_DELAY_MAX);
+        const float reach = opponents.radius[i] + r;
+        // Conservative advancement, as in BallPredictor::intercept
+        float t = 0.0f;
+        for (int step = 0; step < 16 && t < lost; ++step) {
+            float gap = (carrierAt(t) - from).length() - reach - run * std::max(0.0f, t - delay);
+            if (gap <= 0.05f) {
+                lost = t;
+                break;
+            }
+            t += gap / (carry + run);
+        }
+    }
+    if (lost < DRIBBLE_HORIZON) return possessionValue(s, carrierAt(lost), false);
+    return possessionValue(s, carrierAt(DRIBBLE_HORIZON), true);
+}
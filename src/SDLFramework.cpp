@@ -1,40 +1,26 @@
 #include "../include/SDLFramework.h"
 #include <SDL_image.h>
+#include <SDL_ttf.h>
 #include <iostream>
 
-bool scaleTexturePercentage(SDL_Texture* &tex, SDL_Renderer* renderer, float scale) {
-    if (!tex) return false;
-    int w, h;
-    if (SDL_QueryTexture(tex, nullptr, nullptr, &w, &h) != 0) {
-        return false;
-    }
-    int newW = static_cast<int>(w * scale);
-    int newH = static_cast<int>(h * scale);
-    std::cout << "Scaling texture from " << w << "x" << h << " to " << newW << "x" << newH << std::endl;
-    SDL_Texture* scaledTex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
-                                               SDL_TEXTUREACCESS_TARGET, newW, newH);
-    if (!scaledTex) {
-        return false;
-    }
-    // render original texture onto the new one with scaling
-    SDL_SetRenderTarget(renderer, scaledTex);
-    SDL_RenderCopy(renderer, tex, nullptr, nullptr);
-    SDL_SetRenderTarget(renderer, nullptr);
-    // replace original texture with the scaled one
-    SDL_DestroyTexture(tex);
-    tex = scaledTex;
-    return true;
-}
+// Sprite files and the largest size each is kept at in the atlas (the
+// rest of each chain is halved copies); downscaling happens on the CPU
+// while building the atlas
+static const std::vector<SpriteFile> SPRITE_FILES = {
+    { Sprite::FIELD, "assets/sprite/football_field.png", 1024 },
+    { Sprite::BALL,  "assets/sprite/ball.png",           128 },
+    // player sprite (optional)
+    // { Sprite::PLAYER, "assets/sprite/player.png",      128 },
+};
 
 
 SDLFramework::SDLFramework()
-: window(nullptr), renderer(nullptr), fieldTexture(nullptr),
-  ballTexture(nullptr), playerTexture(nullptr), running(false), width(1280), height(720) {}
+: window(nullptr), renderer(nullptr), running(false), fullscreen(false),
+  width(1280), height(720) {}
 
 SDLFramework::~SDLFramework() {
-    if (playerTexture) SDL_DestroyTexture(playerTexture);
-    if (fieldTexture) SDL_DestroyTexture(fieldTexture);
-    if (ballTexture) SDL_DestroyTexture(ballTexture);
+    fieldLayer.release();
+    assets.stop();
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
     IMG_Quit();
@@ -51,6 +37,10 @@ bool SDLFramework::init(const std::string &title, int w, int h) {
         std::cerr << "IMG_Init failed: " << IMG_GetError() << std::endl;
         // continue; not fatal for simple demo
     }
+    if (TTF_Init() == -1) {
+        std::cerr << "TTF_Init failed: " << TTF_GetError() << std::endl;
+        // continue; text just won't show
+    }
 
     window = SDL_CreateWindow(title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
     if (!window) {
@@ -63,73 +53,48 @@ bool SDLFramework::init(const std::string &title, int w, int h) {
         std::cerr << "CreateRenderer Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    // Everything is drawn in width x height coordinates, whatever size the
+    // backbuffer is
+    SDL_RenderSetLogicalSize(renderer, width, height);
 
-    // load our two specific sprites, allow failure
-    fieldTexture = IMG_LoadTexture(renderer, "assets/sprite/football_field.png");
-    if (!fieldTexture) {
-        std::cerr << "Failed to load field texture: " << IMG_GetError() << std::endl;
-    }
-    ballTexture = IMG_LoadTexture(renderer, "assets/sprite/ball.png");
-    if (!ballTexture) {
-        std::cerr << "Failed to load ball texture: " << IMG_GetError() << std::endl;
-    }
-    // load player sprite (optional)
-    // playerTexture = IMG_LoadTexture(renderer, "assets/sprite/player.png");
-    // scaleTexturePercentage(playerTexture, renderer, 0.08f); // scale player sprite to 50% for better fit
-    // if (!playerTexture) {
-    //     std::cerr << "Failed to load player texture: " << IMG_GetError() << std::endl;
-    // }
+    // Decode sprites and fonts in the background so the first frame is
+    // not held up by disk reads; failures are logged and tolerated
+    assets.start(renderer);
+    assets.loadSprites(SPRITE_FILES);
 
     running = true;
     return true;
 }
 
 bool SDLFramework::setResolution(int w, int h) {
-    // destroy renderer and window, then recreate with new size
-    if (playerTexture) {
-        SDL_DestroyTexture(playerTexture);
-        playerTexture = nullptr;
-    }
-    if (renderer) {
-        SDL_DestroyRenderer(renderer);
-        renderer = nullptr;
-    }
-    if (window) {
-        SDL_DestroyWindow(window);
-        window = nullptr;
-    }
-
-    width = w; height = h;
-    window = SDL_CreateWindow("Sigma Strikers - SDL Framework", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
-    if (!window) {
-        std::cerr << "CreateWindow Error (setResolution): " << SDL_GetError() << std::endl;
+    if (!window || !renderer) {
+        std::cerr << "setResolution: no window yet" << std::endl;
         return false;
     }
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!renderer) {
-        std::cerr << "CreateRenderer Error (setResolution): " << SDL_GetError() << std::endl;
+    width = w; height = h;
+    // Resize in place: the renderer, the sprite atlas and the font atlases
+    // survive, and the field layer redraws itself at the new pitch size
+    if (!fullscreen) {
+        SDL_SetWindowSize(window, width, height);
+        SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
+    }
+    if (SDL_RenderSetLogicalSize(renderer, width, height) != 0) {
+        std::cerr << "RenderSetLogicalSize Error (setResolution): " << SDL_GetError() << std::endl;
         return false;
     }
+    return true;
+}
 
-    // reload field and ball textures
-    if (fieldTexture) { SDL_DestroyTexture(fieldTexture); fieldTexture = nullptr; }
-    if (ballTexture) { SDL_DestroyTexture(ballTexture); ballTexture = nullptr; }
-    fieldTexture = IMG_LoadTexture(renderer, "assets/sprite/football_field.png");
-    if (!fieldTexture) {
-        std::cerr << "Failed to reload field texture: " << IMG_GetError() << std::endl;
-    }
-    ballTexture = IMG_LoadTexture(renderer, "assets/sprite/ball.png");
-    if (!ballTexture) {
-        std::cerr << "Failed to reload ball texture: " << IMG_GetError() << std::endl;
+bool SDLFramework::setFullscreen(bool on) {
+    if (!window || !renderer) return false;
+    if (on == fullscreen) return true;
+    if (SDL_SetWindowFullscreen(window, on ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0) != 0) {
+        std::cerr << "SetWindowFullscreen Error: " << SDL_GetError() << std::endl;
+        return false;
     }
-    // playerTexture = IMG_LoadTexture(renderer, "assets/sprite/player.png");
-    // scaleTexturePercentage(playerTexture, renderer, 0.08f); // scale player sprite to 50% for better fit
-
-    // if (!playerTexture) {
-    //     std::cerr << "Failed to load player texture: " << IMG_GetError() << std::endl;
-    // }    
-
-    return true;
+    fullscreen = on;
+    // Back in a window: restore the chosen resolution
+    return setResolution(width, height);
 }
 
 SDL_Renderer* SDLFramework::getRenderer() { return renderer; }
@@ -137,6 +102,11 @@ SDL_Window* SDLFramework::getWindow() { return window; }
 int SDLFramework::getWidth() const { return width; }
 int SDLFramework::getHeight() const { return height; }
 
+std::shared_ptr<FontAtlas> SDLFramework::getFont(const std::string &path, int pointSize) {
+    if (!renderer) return nullptr;
+    return assets.font(path, pointSize);
+}
+
 void SDLFramework::run() {
     SDL_Event e;
     while (running) {
@@ -0,0 +1,248 @@
+#include "../include/ShapeBatch.h"
+#include <algorithm>
+#include <cmath>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "ShapeBatch needs SDL 2.0.18 or newer (SDL_RenderGeometry)"
+#endif
+
+// Circles use 16, 32 or 64 segments depending on their size; all of them
+// step through one table of unit directions.
+static const int CIRCLE_TABLE = 64;
+
+struct UnitCircle {
+    SDL_FPoint dir[CIRCLE_TABLE];
+    UnitCircle() {
+        for (int i = 0; i < CIRCLE_TABLE; ++i) {
+            float a = i * 6.28318531f / CIRCLE_TABLE;
+            dir[i] = SDL_FPoint{std::cos(a), std::sin(a)};
+        }
+    }
+};
+
+static const SDL_FPoint *unitCircle() {
+    static const UnitCircle table;
+    return table.dir;
+}
+
+// Table stride giving segments short enough to look round at radius r.
+static int circleStride(float r) {
+    if (r < 8.0f) return 4;    // 16 segments
+    if (r < 24.0f) return 2;   // 32 segments
+    return 1;                  // 64 segments
+}
+
+ShapeBatch::ShapeBatch(SDL_Renderer *r)
+: renderer(r), texture(nullptr), drawCalls(0) {}
+
+void ShapeBatch::setRenderer(SDL_Renderer *r) {
+    flush();
+    renderer = r;
+}
+
+int ShapeBatch::addVertex(float x, float y, SDL_Color color, float u, float v) {
+    vertices.push_back(SDL_Vertex{{x, y}, color, {u, v}});
+    return (int)vertices.size() - 1;
+}
+
+void ShapeBatch::addQuad(int a, int b, int c, int d) {
+    const int quad[6] = {a, b, c, a, c, d};
+    indices.insert(indices.end(), quad, quad + 6);
+}
+
+void ShapeBatch::useTexture(SDL_Texture *tex) {
+    if (tex != texture) {
+        flush();
+        texture = tex;
+    }
+}
+
+// ============================================================================
+// Shapes
+// ============================================================================
+void ShapeBatch::fillRect(const SDL_FRect &r, SDL_Color color) {
+    if (r.w <= 0.0f || r.h <= 0.0f) return;
+    useTexture(nullptr);
+    int a = addVertex(r.x, r.y, color);
+    int b = addVertex(r.x + r.w, r.y, color);
+    int c = addVertex(r.x + r.w, r.y + r.h, color);
+    int d = addVertex(r.x, r.y + r.h, color);
+    addQuad(a, b, c, d);
+}
+
+void ShapeBatch::drawRect(const SDL_FRect &r, float t, SDL_Color color) {
+    t = std::min(t, std::min(r.w, r.h) / 2.0f);
+    fillRect(SDL_FRect{r.x, r.y, r.w, t}, color);
+    fillRect(SDL_FRect{r.x, r.y + r.h - t, r.w, t}, color);
+    fillRect(SDL_FRect{r.x, r.y + t, t, r.h - 2.0f * t}, color);
+    fillRect(SDL_FRect{r.x + r.w - t, r.y + t, t, r.h - 2.0f * t}, color);
+}
+
+void ShapeBatch::line(float x0, float y0, float x1, float y1, float thickness,
+                      SDL_Color color) {
+    useTexture(nullptr);
+    // SDL_RenderDrawLine lights whole pixels from one end to the other, so
+    // run between pixel centres and extend half a width past each end
+    x0 += 0.5f; y0 += 0.5f;
+    x1 += 0.5f; y1 += 0.5f;
+    float dx = x1 - x0, dy = y1 - y0;
+    float len = std::sqrt(dx * dx + dy * dy);
+    float h = thickness / 2.0f;
+    if (len > 0.0f) {
+        dx = dx / len * h;
+        dy = dy / len * h;
+    } else {
+        dx = h;
+        dy = 0.0f;
+    }
+    // (dx, dy) along the line, (-dy, dx) across it
+    int a = addVertex(x0 - dx + dy, y0 - dy - dx, color);
+    int b = addVertex(x1 + dx + dy, y1 + dy - dx, color);
+    int c = addVertex(x1 + dx - dy, y1 + dy + dx, color);
+    int d = addVertex(x0 - dx - dy, y0 - dy + dx, color);
+    addQuad(a, b, c, d);
+}
+
+void ShapeBatch::fillTriangle(SDL_FPoint p, SDL_FPoint q, SDL_FPoint r, SDL_Color color) {
+    useTexture(nullptr);
+    indices.push_back(addVertex(p.x, p.y, color));
+    indices.push_back(addVertex(q.x, q.y, color));
+    indices.push_back(addVertex(r.x, r.y, color));
+}
+
+void ShapeBatch::fillCircle(float cx, float cy, float radius, SDL_Color color) {
+    if (radius <= 0.0f) return;
+    useTexture(nullptr);
+    const SDL_FPoint *dir = unitCircle();
+    const int stride = circleStride(radius);
+    int centre = addVertex(cx, cy, color);
+    int first = (int)vertices.size();
+    for (int i = 0; i < CIRCLE_TABLE; i += stride) {
+        addVertex(cx + dir[i].x * radius, cy + dir[i].y * radius, color);
+    }
+    int n = (int)vertices.size() - first;
+    for (int i = 0; i < n; ++i) {
+        indices.push_back(centre);
+        indices.push_back(first + i);
+        indices.push_back(first + (i + 1) % n);
+    }
+}
+
+void ShapeBatch::ring(float cx, float cy, float radius, float thickness, SDL_Color color) {
+    if (radius <= 0.0f) return;
+    useTexture(nullptr);
+    const SDL_FPoint *dir = unitCircle();
+    const int stride = circleStride(radius);
+    const float inner = std::max(0.0f, radius - thickness);
+    int first = (int)vertices.size();
+    for (int i = 0; i < CIRCLE_TABLE; i += stride) {
+        addVertex(cx + dir[i].x * radius, cy + dir[i].y * radius, color);
+        addVertex(cx + dir[i].x * inner, cy + dir[i].y * inner, color);
+    }
+    int n = ((int)vertices.size() - first) / 2;
+    for (int i = 0; i < n; ++i) {
+        int j = (i + 1) % n;
+        addQuad(first + 2 * i, first + 2 * j, first + 2 * j + 1, first + 2 * i + 1);
+    }
+}
+
+void ShapeBatch::fillConvex(const SDL_FPoint *pts, int count, SDL_Color color) {
+    if (count < 3) return;
+    useTexture(nullptr);
+    int first = (int)vertices.size();
+    for (int i = 0; i < count; ++i) addVertex(pts[i].x, pts[i].y, color);
+    for (int i = 1; i + 1 < count; ++i) {
+        indices.push_back(first);
+        indices.push_back(first + i);
+        indices.push_back(first + i + 1);
+    }
+}
+
+static float cross(const SDL_FPoint &o, const SDL_FPoint &a, const SDL_FPoint &b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+void ShapeBatch::fillPolygon(const SDL_FPoint *pts, int count, SDL_Color color) {
+    if (count < 3) return;
+    useTexture(nullptr);
+    int first = (int)vertices.size();
+    for (int i = 0; i < count; ++i) addVertex(pts[i].x, pts[i].y, color);
+
+    // Orientation decides which side of an edge counts as "inside"
+    float area2 = 0.0f;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        area2 += pts[j].x * pts[i].y - pts[i].x * pts[j].y;
+    }
+    const float sign = area2 < 0.0f ? -1.0f : 1.0f;
+
+    // Clip convex corners with no other vertex inside until a triangle is
+    // left; give up on the rest if the outline is degenerate
+    std::vector<int> &remaining = earScratch;
+    remaining.resize(count);
+    for (int i = 0; i < count; ++i) remaining[i] = i;
+    int guard = 2 * count;
+    while (remaining.size() > 3 && guard-- > 0) {
+        int n = (int)remaining.size();
+        for (int k = 0; k < n; ++k) {
+            int ip = remaining[(k + n - 1) % n];
+            int ic = remaining[k];
+            int in = remaining[(k + 1) % n];
+            const SDL_FPoint &p = pts[ip], &c = pts[ic], &q = pts[in];
+            if (sign * cross(p, c, q) <= 0.0f) continue;   // reflex corner
+            bool ear = true;
+            for (int m = 0; m < n && ear; ++m) {
+                int o = remaining[m];
+                if (o == ip || o == ic || o == in) continue;
+                ear = !(sign * cross(p, c, pts[o]) >= 0.0f &&
+                        sign * cross(c, q, pts[o]) >= 0.0f &&
+                        sign * cross(q, p, pts[o]) >= 0.0f);
+            }
+            if (!ear) continue;
+            indices.push_back(first + ip);
+            indices.push_back(first + ic);
+            indices.push_back(first + in);
+            remaining.erase(remaining.begin() + k);
+            break;
+        }
+    }
+    if (remaining.size() == 3) {
+        for (int i : remaining) indices.push_back(first + i);
+    }
+}
+
+void ShapeBatch::drawPolygon(const SDL_FPoint *pts, int count, float thickness,
+                             SDL_Color color) {
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        line(pts[j].x, pts[j].y, pts[i].x, pts[i].y, thickness, color);
+    }
+}
+
+void ShapeBatch::sprite(SDL_Texture *tex, const SDL_FRect &dst, SDL_Color tint) {
+    sprite(tex, dst, SDL_FRect{0.0f, 0.0f, 1.0f, 1.0f}, tint);
+}
+
+void ShapeBatch::sprite(SDL_Texture *tex, const SDL_FRect &dst, const SDL_FRect &uv,
+                        SDL_Color tint) {
+    if (!tex) return;
+    useTexture(tex);
+    int a = addVertex(dst.x, dst.y, tint, uv.x, uv.y);
+    int b = addVertex(dst.x + dst.w, dst.y, tint, uv.x + uv.w, uv.y);
+    int c = addVertex(dst.x + dst.w, dst.y + dst.h, tint, uv.x + uv.w, uv.y + uv.h);
+    int d = addVertex(dst.x, dst.y + dst.h, tint, uv.x, uv.y + uv.h);
+    addQuad(a, b, c, d);
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+void ShapeBatch::flush() {
+    if (!indices.empty() && renderer) {
+        // Untextured geometry blends with the renderer's draw blend mode
+        if (!texture) SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_RenderGeometry(renderer, texture, vertices.data(), (int)vertices.size(),
+                           indices.data(), (int)indices.size());
+        drawCalls++;
+    }
+    vertices.clear();
+    indices.clear();
+}
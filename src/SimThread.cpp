@@ -0,0 +1,133 @@
+#include "../include/SimThread.h"
+#include "../include/Replay.h"
+#include <algorithm>
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+float MatchSnapshot::renderAlpha() const {
+    float since = std::chrono::duration<float>(std::chrono::steady_clock::now() - takenAt).count();
+    return std::min(1.0f, alpha + since / MatchSimulation::FIXED_DT);
+}
+
+Ball MatchSnapshot::renderBall(float a) const {
+    Ball b = ball;
+    b.pos = prevBall.pos.lerp(ball.pos, a);
+    return b;
+}
+
+Team MatchSnapshot::renderTeam1(float a) const {
+    Team t = team1;
+    t.players.interpolate(prevTeam1.players, team1.players, a);
+    return t;
+}
+
+Team MatchSnapshot::renderTeam2(float a) const {
+    Team t = team2;
+    t.players.interpolate(prevTeam2.players, team2.players, a);
+    return t;
+}
+
+// ============================================================================
+// Control (caller's thread)
+// ============================================================================
+SimThread::SimThread(MatchSimulation &sim, ReplayPlayer *replay, float replaySpeed)
+: sim(sim), replay(replay), replaySpeed(replaySpeed), stopping(false),
+  moves1(0), moves2(0), swaps1(0), swaps2(0), usedSwaps1(0), usedSwaps2(0),
+  lastEvent(MatchEvent::NONE), eventCount(0) {}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+void SimThread::start() {
+    if (thread.joinable()) return;
+    // Presses made while stopped don't carry over into the new run
+    usedSwaps1 = swaps1.load();
+    usedSwaps2 = swaps2.load();
+    publish();
+    stopping = false;
+    thread = std::thread([this]() { run(); });
+}
+
+void SimThread::stop() {
+    if (!thread.joinable()) return;
+    stopping = true;
+    thread.join();
+}
+
+void SimThread::setInputs(const MatchInputs &inputs) {
+    moves1.store(packTeamInput(inputs.team1), std::memory_order_relaxed);
+    moves2.store(packTeamInput(inputs.team2), std::memory_order_relaxed);
+}
+
+void SimThread::pressSwap(int team) {
+    (team == 1 ? swaps1 : swaps2).fetch_add(1, std::memory_order_relaxed);
+}
+
+const MatchSnapshot &SimThread::latest() {
+    snapshots.acquire();
+    return snapshots.front();
+}
+
+// ============================================================================
+// Simulation thread
+// ============================================================================
+void SimThread::publish() {
+    MatchSnapshot &s = snapshots.back();
+    s.prevBall = sim.getPrevBall();
+    s.ball = sim.getBall();
+    s.prevTeam1 = sim.getPrevTeam1();
+    s.team1 = sim.getTeam1();
+    s.prevTeam2 = sim.getPrevTeam2();
+    s.team2 = sim.getTeam2();
+    s.alpha = sim.getInterpolationAlpha();
+    s.takenAt = std::chrono::steady_clock::now();
+    s.timeRemaining = sim.getTimeRemaining();
+    s.over = sim.isOver();
+    s.leader = sim.getLeader();
+    s.lastEvent = lastEvent;
+    s.eventCount = eventCount;
+    snapshots.publish();
+}
+
+void SimThread::run() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point last = Clock::now();
+    while (!stopping) {
+        Clock::time_point now = Clock::now();
+        float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        MatchEvent ev;
+        if (replay) {
+            ev = sim.advance(dt, *replay, replaySpeed);
+        } else {
+            // The movement keys are levels; a swap is any press not yet
+            // passed on
+            MatchInputs inputs;
+            inputs.team1 = unpackTeamInput(moves1.load(std::memory_order_relaxed));
+            inputs.team2 = unpackTeamInput(moves2.load(std::memory_order_relaxed));
+            uint32_t s1 = swaps1.load(std::memory_order_relaxed);
+            uint32_t s2 = swaps2.load(std::memory_order_relaxed);
+            inputs.team1.swap = (s1 != usedSwaps1);
+            inputs.team2.swap = (s2 != usedSwaps2);
+            usedSwaps1 = s1;
+            usedSwaps2 = s2;
+            ev = sim.advance(dt, inputs);
+        }
+        if (ev != MatchEvent::NONE) {
+            lastEvent = ev;
+            eventCount++;
+        }
+        publish();
+
+        // Sleep until the next step is due; a finished match (or replay)
+        // holds alpha at 1 and only needs to keep answering stop()
+        float alpha = sim.getInterpolationAlpha();
+        float wait = (sim.isOver() || alpha >= 1.0f)
+                         ? MatchSimulation::FIXED_DT
+                         : (1.0f - alpha) * MatchSimulation::FIXED_DT;
+        std::this_thread::sleep_for(std::chrono::microseconds((long long)(wait * 1e6f)));
+    }
+}
@@ -0,0 +1,95 @@
+#include "../include/SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float width, float height, float cellSize)
+    : cellSize(cellSize),
+      invCellSize(1.0f / cellSize),
+      cols(std::max(1, (int)std::ceil(width / cellSize))),
+      rows(std::max(1, (int)std::ceil(height / cellSize))),
+      cells(cols * rows) {}
+
+void SpatialGrid::clear() {
+    for (std::vector<int> &cell : cells) cell.clear();
+    ranges.clear();
+}
+
+SpatialGrid::CellRange SpatialGrid::rangeFor(float minX, float minY,
+                                             float maxX, float maxY) const {
+    auto cellX = [this](float x) {
+        int c = (int)std::floor(x * invCellSize);
+        return std::min(std::max(c, 0), cols - 1);
+    };
+    auto cellY = [this](float y) {
+        int c = (int)std::floor(y * invCellSize);
+        return std::min(std::max(c, 0), rows - 1);
+    };
+    return CellRange{cellX(minX), cellY(minY), cellX(maxX), cellY(maxY)};
+}
+
+void SpatialGrid::addToCells(int id, const CellRange &r) {
+    for (int cy = r.y0; cy <= r.y1; ++cy) {
+        for (int cx = r.x0; cx <= r.x1; ++cx) {
+            cells[cy * cols + cx].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::removeFromCells(int id, const CellRange &r) {
+    for (int cy = r.y0; cy <= r.y1; ++cy) {
+        for (int cx = r.x0; cx <= r.x1; ++cx) {
+            std::vector<int> &cell = cells[cy * cols + cx];
+            auto it = std::find(cell.begin(), cell.end(), id);
+            if (it != cell.end()) {
+                // order inside a cell does not matter, query() sorts
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+void SpatialGrid::insert(int id, float minX, float minY, float maxX, float maxY) {
+    if (id >= (int)ranges.size()) {
+        ranges.resize(id + 1, CellRange{-1, -1, -1, -1});
+    }
+    CellRange r = rangeFor(minX, minY, maxX, maxY);
+    ranges[id] = r;
+    addToCells(id, r);
+}
+
+void SpatialGrid::update(int id, float minX, float minY, float maxX, float maxY) {
+    if (id >= (int)ranges.size() || ranges[id].x0 < 0) {
+        insert(id, minX, minY, maxX, maxY);
+        return;
+    }
+    CellRange r = rangeFor(minX, minY, maxX, maxY);
+    const CellRange &old = ranges[id];
+    if (r.x0 == old.x0 && r.y0 == old.y0 && r.x1 == old.x1 && r.y1 == old.y1) {
+        return;
+    }
+    removeFromCells(id, old);
+    addToCells(id, r);
+    ranges[id] = r;
+}
+
+void SpatialGrid::remove(int id) {
+    if (id >= (int)ranges.size() || ranges[id].x0 < 0) return;
+    removeFromCells(id, ranges[id]);
+    ranges[id] = CellRange{-1, -1, -1, -1};
+}
+
+void SpatialGrid::query(float minX, float minY, float maxX, float maxY,
+                        std::vector<int> &out) const {
+    out.clear();
+    CellRange r = rangeFor(minX, minY, maxX, maxY);
+    for (int cy = r.y0; cy <= r.y1; ++cy) {
+        for (int cx = r.x0; cx <= r.x1; ++cx) {
+            const std::vector<int> &cell = cells[cy * cols + cx];
+            out.insert(out.end(), cell.begin(), cell.end());
+        }
+    }
+    // a box spanning several cells sees multi-cell entries more than once
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
@@ -0,0 +1,342 @@
+#include "../include/SpriteAtlas.h"
+#include "../include/ShapeBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+// Page width; a wider image gets a page as wide as itself
+static const int PAGE_WIDTH = 1024;
+// Border around each cell; the cell's edge pixels are repeated into it so
+// linear filtering never samples a neighbouring cell
+static const int GUTTER = 1;
+
+SpriteAtlas::SpriteAtlas()
+: renderer(nullptr), texture(nullptr), pageW(0), pageH(0), uploadedRows(0) {}
+
+SpriteAtlas::~SpriteAtlas() {
+    release();
+}
+
+void SpriteAtlas::release() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+    renderer = nullptr;
+    pageW = pageH = 0;
+    page.clear();
+    page.shrink_to_fit();
+    uploadedRows = 0;
+    for (std::vector<Level> &l : levels) l.clear();
+}
+
+void SpriteAtlas::swap(SpriteAtlas &other) {
+    std::swap(renderer, other.renderer);
+    std::swap(texture, other.texture);
+    std::swap(pageW, other.pageW);
+    std::swap(pageH, other.pageH);
+    page.swap(other.page);
+    std::swap(uploadedRows, other.uploadedRows);
+    for (int i = 0; i < (int)Sprite::COUNT; ++i) levels[i].swap(other.levels[i]);
+    pending.swap(other.pending);
+}
+
+// ============================================================================
+// CPU-side images
+// ============================================================================
+SpriteAtlas::Image SpriteAtlas::fromSurface(SDL_Surface *surface) {
+    Image img;
+    SDL_Surface *rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) {
+        std::cerr << "Sprite conversion failed: " << SDL_GetError() << std::endl;
+        return img;
+    }
+    if (SDL_MUSTLOCK(rgba)) SDL_LockSurface(rgba);
+    img.w = rgba->w;
+    img.h = rgba->h;
+    img.rgba.resize((size_t)img.w * img.h * 4);
+    for (int y = 0; y < img.h; ++y) {
+        std::memcpy(&img.rgba[(size_t)y * img.w * 4],
+                    (const uint8_t *)rgba->pixels + (size_t)y * rgba->pitch, (size_t)img.w * 4);
+    }
+    if (SDL_MUSTLOCK(rgba)) SDL_UnlockSurface(rgba);
+    SDL_FreeSurface(rgba);
+    return img;
+}
+
+// Area average of src over each destination pixel.  Colours are weighted
+// by alpha so transparent pixels (often black) don't darken the edges.
+SpriteAtlas::Image SpriteAtlas::resample(const Image &src, int w, int h) {
+    Image dst;
+    dst.w = w;
+    dst.h = h;
+    dst.rgba.resize((size_t)w * h * 4);
+    for (int y = 0; y < h; ++y) {
+        int y0 = y * src.h / h;
+        int y1 = std::max(y0 + 1, (y + 1) * src.h / h);
+        for (int x = 0; x < w; ++x) {
+            int x0 = x * src.w / w;
+            int x1 = std::max(x0 + 1, (x + 1) * src.w / w);
+            uint32_t r = 0, g = 0, b = 0, a = 0, n = 0;
+            for (int sy = y0; sy < y1; ++sy) {
+                const uint8_t *p = &src.rgba[((size_t)sy * src.w + x0) * 4];
+                for (int sx = x0; sx < x1; ++sx, p += 4) {
+                    r += p[0] * p[3];
+                    g += p[1] * p[3];
+                    b += p[2] * p[3];
+                    a += p[3];
+                    n++;
+                }
+            }
+            uint8_t *out = &dst.rgba[((size_t)y * w + x) * 4];
+            if (a > 0) {
+                out[0] = (uint8_t)((r + a / 2) / a);
+                out[1] = (uint8_t)((g + a / 2) / a);
+                out[2] = (uint8_t)((b + a / 2) / a);
+            } else {
+                out[0] = out[1] = out[2] = 0;
+            }
+            out[3] = (uint8_t)((a + n / 2) / n);
+        }
+    }
+    return dst;
+}
+
+SpriteAtlas::Image SpriteAtlas::halve(const Image &src) {
+    return resample(src, std::max(1, src.w / 2), std::max(1, src.h / 2));
+}
+
+void SpriteAtlas::addLevels(Sprite id, Image base) {
+    Pending p;
+    p.id = id;
+    p.levels.push_back(std::move(base));
+    while (p.levels.back().w / 2 >= MIN_LEVEL && p.levels.back().h / 2 >= MIN_LEVEL) {
+        p.levels.push_back(halve(p.levels.back()));
+    }
+    // Replaces anything queued earlier under the same id
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [id](const Pending &q) { return q.id == id; }),
+                  pending.end());
+    pending.push_back(std::move(p));
+}
+
+bool SpriteAtlas::addImage(Sprite id, SDL_Surface *surface, int maxSize) {
+    if (!surface || surface->w <= 0 || surface->h <= 0) return false;
+    Image img = fromSurface(surface);
+    if (img.rgba.empty()) return false;
+    int longest = std::max(img.w, img.h);
+    if (maxSize > 0 && longest > maxSize) {
+        float s = (float)maxSize / longest;
+        int w = std::max(1, (int)std::lround(img.w * s));
+        int h = std::max(1, (int)std::lround(img.h * s));
+        // Halve first while that stays above the target: cheaper than one
+        // big area average and just as good
+        while (img.w / 2 >= w && img.h / 2 >= h) img = halve(img);
+        if (img.w != w || img.h != h) img = resample(img, w, h);
+    }
+    addLevels(id, std::move(img));
+    return true;
+}
+
+// ============================================================================
+// Procedural shapes, drawn white with analytic coverage so the edges are
+// antialiased at every level
+// ============================================================================
+static float coverage(float signedDistance) {
+    // signedDistance > 0 inside; one pixel wide ramp
+    return std::max(0.0f, std::min(1.0f, signedDistance + 0.5f));
+}
+
+static float segmentDistance(float px, float py, float ax, float ay, float bx, float by) {
+    float dx = bx - ax, dy = by - ay;
+    float t = ((px - ax) * dx + (py - ay) * dy) / (dx * dx + dy * dy);
+    t = std::max(0.0f, std::min(1.0f, t));
+    float ex = px - (ax + t * dx), ey = py - (ay + t * dy);
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+template <typename F>
+static void paint(std::vector<uint8_t> &rgba, int w, int h, F alphaAt) {
+    rgba.resize((size_t)w * h * 4);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            uint8_t *p = &rgba[((size_t)y * w + x) * 4];
+            p[0] = p[1] = p[2] = 255;
+            p[3] = (uint8_t)std::lround(255.0f * alphaAt(x + 0.5f, y + 0.5f));
+        }
+    }
+}
+
+void SpriteAtlas::addShapes() {
+    const int size = 64;
+    const float c = size / 2.0f;
+    const float r = size / 2.0f - 0.5f;
+    // A 1 px outline at the ~16 px radius players usually have
+    const float ringWidth = size / 16.0f;
+
+    Image disc;
+    disc.w = disc.h = size;
+    paint(disc.rgba, size, size, [&](float x, float y) {
+        return coverage(r - std::hypot(x - c, y - c));
+    });
+    addLevels(Sprite::DISC, std::move(disc));
+
+    Image ring;
+    ring.w = ring.h = size;
+    paint(ring.rgba, size, size, [&](float x, float y) {
+        float d = std::hypot(x - c, y - c);
+        return coverage(std::min(r - d, d - (r - ringWidth)));
+    });
+    addLevels(Sprite::RING, std::move(ring));
+
+    // The old 10 x 8 px three-line arrow at 4x: apex at the top centre,
+    // strokes between pixel centres
+    const int mw = 44, mh = 36;
+    const float stroke = 4.0f;
+    const float ax = 22.0f, ay = 2.0f, lx = 2.0f, rx = 42.0f, by = 34.0f;
+    Image marker;
+    marker.w = mw;
+    marker.h = mh;
+    paint(marker.rgba, mw, mh, [&](float x, float y) {
+        float d = std::min(segmentDistance(x, y, ax, ay, lx, by),
+                  std::min(segmentDistance(x, y, ax, ay, rx, by),
+                           segmentDistance(x, y, lx, by, rx, by)));
+        return coverage(stroke / 2.0f - d);
+    });
+    addLevels(Sprite::MARKER, std::move(marker));
+}
+
+// ============================================================================
+// Packing and upload
+// ============================================================================
+bool SpriteAtlas::build(SDL_Renderer *target) {
+    if (!target) {
+        pending.clear();
+        return false;
+    }
+    return pack() && upload(target, pageH);
+}
+
+bool SpriteAtlas::pack() {
+    std::vector<Pending> queued;
+    queued.swap(pending);
+    release();
+    if (queued.empty()) return false;
+
+    // Every level of every sprite is one cell
+    struct Cell {
+        const Image *img;
+        int sprite, level;
+        int x, y;
+    };
+    std::vector<Cell> cells;
+    int widest = 0;
+    for (const Pending &p : queued) {
+        for (size_t l = 0; l < p.levels.size(); ++l) {
+            cells.push_back(Cell{&p.levels[l], (int)p.id, (int)l, 0, 0});
+            widest = std::max(widest, p.levels[l].w + 2 * GUTTER);
+        }
+    }
+
+    // Shelf packing, tallest first
+    std::sort(cells.begin(), cells.end(), [](const Cell &a, const Cell &b) {
+        return a.img->h != b.img->h ? a.img->h > b.img->h : a.img->w > b.img->w;
+    });
+    const int w = std::max(PAGE_WIDTH, widest);
+    int penX = 0, shelfY = 0, shelfH = 0;
+    for (Cell &cell : cells) {
+        int cw = cell.img->w + 2 * GUTTER;
+        int ch = cell.img->h + 2 * GUTTER;
+        if (penX + cw > w) {
+            shelfY += shelfH;
+            penX = 0;
+            shelfH = 0;
+        }
+        cell.x = penX;
+        cell.y = shelfY;
+        penX += cw;
+        shelfH = std::max(shelfH, ch);
+    }
+    const int h = shelfY + shelfH;
+
+    page.assign((size_t)w * h * 4, 0);
+    for (const Cell &cell : cells) {
+        const Image &img = *cell.img;
+        // Interior plus gutter, clamping source coordinates to the edge
+        for (int y = -GUTTER; y < img.h + GUTTER; ++y) {
+            int sy = std::max(0, std::min(img.h - 1, y));
+            uint8_t *row = &page[((size_t)(cell.y + GUTTER + y) * w + cell.x) * 4];
+            for (int x = -GUTTER; x < img.w + GUTTER; ++x) {
+                int sx = std::max(0, std::min(img.w - 1, x));
+                std::memcpy(row + (size_t)(x + GUTTER) * 4,
+                            &img.rgba[((size_t)sy * img.w + sx) * 4], 4);
+            }
+        }
+    }
+
+    pageW = w;
+    pageH = h;
+    for (const Pending &p : queued) {
+        levels[(int)p.id].resize(p.levels.size());
+    }
+    for (const Cell &cell : cells) {
+        levels[cell.sprite][cell.level] = Level{
+            cell.img->w, cell.img->h,
+            SDL_FRect{(float)(cell.x + GUTTER) / w, (float)(cell.y + GUTTER) / h,
+                      (float)cell.img->w / w, (float)cell.img->h / h}};
+    }
+    return true;
+}
+
+bool SpriteAtlas::upload(SDL_Renderer *target, int maxRows) {
+    if (page.empty()) return texture != nullptr;
+    if (!texture) {
+        texture = SDL_CreateTexture(target, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                    pageW, pageH);
+        if (!texture) {
+            std::cerr << "Sprite atlas (" << pageW << "x" << pageH << ") unavailable: "
+                      << SDL_GetError() << std::endl;
+            release();
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+        SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+#endif
+        renderer = target;
+    }
+
+    int rows = std::min(std::max(1, maxRows), pageH - uploadedRows);
+    SDL_Rect band = {0, uploadedRows, pageW, rows};
+    if (SDL_UpdateTexture(texture, &band, &page[(size_t)uploadedRows * pageW * 4],
+                          pageW * 4) != 0) {
+        std::cerr << "Sprite atlas upload failed: " << SDL_GetError() << std::endl;
+        release();
+        return false;
+    }
+    uploadedRows += rows;
+    if (uploadedRows >= pageH) {
+        page.clear();
+        page.shrink_to_fit();
+    }
+    return true;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+SDL_FRect SpriteAtlas::uvFor(Sprite id, float w, float h) const {
+    const std::vector<Level> &chain = levels[(int)id];
+    if (chain.empty()) return SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f};
+    // Levels shrink along the chain; stop at the last one still covering dst
+    size_t pick = 0;
+    while (pick + 1 < chain.size() && chain[pick + 1].w >= w && chain[pick + 1].h >= h) {
+        ++pick;
+    }
+    return chain[pick].uv;
+}
+
+void SpriteAtlas::draw(ShapeBatch &batch, Sprite id, const SDL_FRect &dst,
+                       SDL_Color tint) const {
+    if (!has(id)) return;
+    batch.sprite(texture, dst, uvFor(id, dst.w, dst.h), tint);
+}
@@ -9,147 +9,68 @@ static float clamp(float v, float lo, float hi) {
     return v;
 }
 
-void Player::update(float dt, const Uint8 *keyState, const KeyBindings &keys,
-                    const Field *bounds) {
-    Vector dir(0, 0);
-    if (keyState[keys.up])    dir.y -= 1;
-    if (keyState[keys.down])  dir.y += 1;
-    if (keyState[keys.left])  dir.x -= 1;
-    if (keyState[keys.right]) dir.x += 1;
-    if (dir.x != 0 || dir.y != 0) {
-        float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-        dir /= len;
-        pos += dir * speed * dt;
-    }
-    if (bounds) {
-        pos.x = clamp(pos.x, radius, bounds->getWidth() - radius);
-        pos.y = clamp(pos.y, radius, bounds->getHeight() - radius);
-    }
+TeamInput TeamInput::fromKeyboard(const Uint8 *keyState, const KeyBindings &keys) {
+    TeamInput in;
+    in.up    = keyState[keys.up] != 0;
+    in.down  = keyState[keys.down] != 0;
+    in.left  = keyState[keys.left] != 0;
+    in.right = keyState[keys.right] != 0;
+    in.swap  = false;
+    return in;
 }
 
-// draw a simple filled circle
-static void drawFilledCircle(SDL_Renderer *renderer, int cx, int cy, int r) {
-    for (int dy = -r; dy <= r; ++dy) {
-        int dx = static_cast<int>(std::sqrt(r*r - dy*dy));
-        SDL_RenderDrawLine(renderer, cx - dx, cy + dy, cx + dx, cy + dy);
+Team::Team(const std::vector<Vector> &starts, KeyBindings kb)
+    : activeIndex(0), score(0), keys(kb) {
+    for (const Vector &start : starts) {
+        players.add(start);
     }
 }
 
-void Player::render(SDL_Renderer *renderer, const Field &field,
-                    int screenW, int screenH, SDL_Color color, SDL_Texture *tex) const {
-    // map world coords into field viewport
-    SDL_FPoint p = field.worldToScreen(pos.x, pos.y, screenW, screenH);
-    SDL_Rect vp = field.getViewport(screenW, screenH);
-    float sx = (float)vp.w / field.getWidth();
-    float sy = (float)vp.h / field.getHeight();
-
-    int px = static_cast<int>(p.x);
-    int py = static_cast<int>(p.y);
-    int pr = static_cast<int>(radius * std::min(sx, sy));
-    if (pr < 6) pr = 6;
+void Team::update(float dt, const Uint8 *keyState, const Field *bounds) {
+    update(dt, TeamInput::fromKeyboard(keyState, keys), bounds);
+}
 
-    if (tex) {
-        // Draw the player sprite, tinted with team color
-        SDL_SetTextureColorMod(tex, color.r, color.g, color.b);
-        SDL_SetTextureAlphaMod(tex, color.a);
-        // Scale sprite to fit nicely on the field
-        int spriteSize = pr * 3;  // 1.5x diameter
-        SDL_Rect dst = { px - spriteSize / 2, py - spriteSize / 2,
-                         spriteSize, spriteSize };
-        SDL_RenderCopy(renderer, tex, nullptr, &dst);
-        // Reset tint
-        SDL_SetTextureColorMod(tex, 255, 255, 255);
-        SDL_SetTextureAlphaMod(tex, 255);
-    } else {
-        // Fallback: draw circle
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        drawFilledCircle(renderer, px, py, pr);
+void Team::update(float dt, const TeamInput &input, const Field *bounds) {
+    if (input.swap) swapActive();
+    if (players.size() == 0) return;
 
-        // Outline
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-        for (int deg = 0; deg < 360; deg += 2) {
-            float rad = deg * 3.14159f / 180.0f;
-            int bx = px + (int)(pr * std::cos(rad));
-            int by = py + (int)(pr * std::sin(rad));
-            SDL_RenderDrawPoint(renderer, bx, by);
-        }
+    int i = activeIndex;
+    Vector dir(0, 0);
+    if (input.up)    dir.y -= 1;
+    if (input.down)  dir.y += 1;
+    if (input.left)  dir.x -= 1;
+    if (input.right) dir.x += 1;
+    if (dir.x != 0 || dir.y != 0) {
+        float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+        dir /= len;
+        players.translate(i, dir * players.speed[i] * dt);
+    }
+    if (bounds) {
+        float r = players.radius[i];
+        players.x[i] = clamp(players.x[i], r, bounds->getWidth() - r);
+        players.y[i] = clamp(players.y[i], r, bounds->getHeight() - r);
     }
-}
-
-void Team::update(float dt, const Uint8 *keyState, const Field *bounds) {
-    getActivePlayer().update(dt, keyState, keys, bounds);
 }
 
 void Team::handleEvent(const SDL_Event &e) {
-    if (e.type == SDL_KEYDOWN && e.key.keysym.sym == keys.swap) {
+    if (isSwapEvent(e)) {
         swapActive();
     }
 }
 
-void Team::render(SDL_Renderer *renderer, const Field &field,
-                  int screenW, int screenH,
-                  SDL_Color activeColor, SDL_Color inactiveColor,
-                  SDL_Texture *playerTex) const {
-    // Draw inactive player (dimmer)
-    const Player &inactive = (activeIndex == 0) ? p2 : p1;
-    inactive.render(renderer, field, screenW, screenH, inactiveColor, playerTex);
-
-    // Draw active player (brighter) on top
-    const Player &active = (activeIndex == 0) ? p1 : p2;
-    active.render(renderer, field, screenW, screenH, activeColor, playerTex);
-
-    // Draw an indicator arrow above the active player
-    float sx = screenW / field.getWidth();
-    float sy = screenH / field.getHeight();
-    int ax = static_cast<int>(active.pos.x * sx);
-    int ay = static_cast<int>(active.pos.y * sy);
-    int arrPr = static_cast<int>(active.radius * std::min(sx, sy));
-    if (arrPr < 6) arrPr = 6;
-    int sprHalf = arrPr * 3 / 2; // match sprite half-size
-
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-    // Small triangle above player sprite
-    int triTop = ay - sprHalf - 12;
-    int triBot = ay - sprHalf - 4;
-    SDL_RenderDrawLine(renderer, ax, triTop, ax - 5, triBot);
-    SDL_RenderDrawLine(renderer, ax, triTop, ax + 5, triBot);
-    SDL_RenderDrawLine(renderer, ax - 5, triBot, ax + 5, triBot);
-}
-
-Player &Team::getActivePlayer() {
-    return (activeIndex == 0) ? p1 : p2;
-}
-
-const Player &Team::getActivePlayer() const {
-    return (activeIndex == 0) ? p1 : p2;
-}
-
-Player &Team::getInactivePlayer() {
-    return (activeIndex == 0) ? p2 : p1;
-}
-
-const Player &Team::getInactivePlayer() const {
-    return (activeIndex == 0) ? p2 : p1;
+bool Team::isSwapEvent(const SDL_Event &e) const {
+    return e.type == SDL_KEYDOWN && e.key.keysym.sym == keys.swap;
 }
 
 void Team::swapActive() {
-    activeIndex = 1 - activeIndex;
+    if (players.size() == 0) return;
+    activeIndex = (activeIndex + 1) % players.size();
 }
 
-void Team::resetPositions(const Vector &start1, const Vector &start2) {
-    p1.pos = start1;
-    p2.pos = start2;
-}
-
-// new helper for Player movement
-void Player::move(float dx, float dy, float dt, const Field *bounds) {
-    if (dx != 0 || dy != 0) {
-        float len = std::sqrt(dx*dx + dy*dy);
-        Vector dir = { dx/len, dy/len };
-        pos += dir * speed * dt;
-    }
-    if (bounds) {
-        pos.x = clamp(pos.x, 0.0f, bounds->getWidth());
-        pos.y = clamp(pos.y, 0.0f, bounds->getHeight());
+void Team::resetPositions(const std::vector<Vector> &starts) {
+    for (int i = 0; i < players.size() && i < (int)starts.size(); ++i) {
+        players.setPos(i, starts[i]);
+        players.vx[i] = 0.0f;
+        players.vy[i] = 0.0f;
     }
 }
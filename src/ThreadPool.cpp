@@ -0,0 +1,103 @@
+#include "../include/ThreadPool.h"
+
+// Index of the worker running on this thread, -1 outside the pool.
+static thread_local int tlsWorker = -1;
+static thread_local const ThreadPool *tlsPool = nullptr;
+
+ThreadPool::ThreadPool(int threads)
+    : queued(0), pending(0), nextQueue(0), stopping(false) {
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    for (int i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lk(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread &t : workers) t.join();
+}
+
+void ThreadPool::submit(Task task) {
+    int target;
+    if (tlsPool == this) {
+        target = tlsWorker;
+    } else {
+        target = (int)(nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+    }
+
+    pending.fetch_add(1);
+    {
+        Queue &q = *queues[target];
+        std::lock_guard<std::mutex> lk(q.lock);
+        q.tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+
+    // Taking the lock orders this against a worker that has just found
+    // nothing to do and is about to sleep
+    { std::lock_guard<std::mutex> lk(sleepLock); }
+    wakeUp.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lk(sleepLock);
+    allDone.wait(lk, [this] { return pending.load() == 0; });
+}
+
+bool ThreadPool::takeTask(int self, Task &task) {
+    {
+        Queue &q = *queues[self];
+        std::lock_guard<std::mutex> lk(q.lock);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    int n = (int)queues.size();
+    for (int k = 1; k < n; ++k) {
+        Queue &q = *queues[(self + k) % n];
+        std::lock_guard<std::mutex> lk(q.lock);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int self) {
+    tlsWorker = self;
+    tlsPool = this;
+
+    Task task;
+    while (true) {
+        if (takeTask(self, task)) {
+            task();
+            task = nullptr;
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lk(sleepLock);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(sleepLock);
+        wakeUp.wait(lk, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -1,44 +1,26 @@
 #include "../include/SDLFramework.h"
-#include "../include/Field.h"
-#include "../include/Obstacle.h"
-#include "../include/Ball.h"
-#include "../include/Team.h"
+#include "../include/MatchSimulation.h"
 #include "../include/Menu.h"
 #include "../include/HUD.h"
-#include "../include/AIAgent.h"
+#include "../include/Replay.h"
+#include "../include/ShapeBatch.h"
+#include "../include/Camera.h"
+#include "../include/Profiler.h"
+#include "../include/ProfilerOverlay.h"
+#include "../include/ThreadPool.h"
+#include "../include/SimThread.h"
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
 #include <cmath>
+#include <memory>
 #include <string>
+#include <thread>
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
-// ============================================================================
-// Game state
-// ============================================================================
-enum GameMode {
-    MODE_VS_AI,   // Player vs AI (single player controls Team 1)
-    MODE_PVP      // Player vs Player (local 2-player)
-};
-
-// Reset positions after a goal
-static void resetAfterGoal(Team &team1, Team &team2, Ball &ball, const Field &field) {
-    // Team 1 on left side
-    team1.resetPositions(
-        Vector(field.getWidth() * 0.2f, field.getHeight() * 0.35f),
-        Vector(field.getWidth() * 0.2f, field.getHeight() * 0.65f)
-    );
-    // Team 2 on right side
-    team2.resetPositions(
-        Vector(field.getWidth() * 0.8f, field.getHeight() * 0.35f),
-        Vector(field.getWidth() * 0.8f, field.getHeight() * 0.65f)
-    );
-    // Ball to center
-    ball.reset(Vector(field.getWidth() / 2.0f, field.getHeight() / 2.0f), Vector(0, 0));
-}
-
 // ============================================================================
 // Main
 // ============================================================================
@@ -51,6 +33,31 @@ int main(int argc, char** argv) {
 #endif
     SDL_Log("=== Sigma Strikers starting ===");
 
+    // Command line:
+    //   --record <file>   save the match inputs as a replay
+    //   --replay <file>   watch a recorded match instead of playing
+    //   --speed <x>       replay playback speed (default 1)
+    std::string recordPath, replayPath;
+    float replaySpeed = 1.0f;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            replaySpeed = (float)std::atof(argv[++i]);
+        } else {
+            SDL_Log("Unknown argument: %s", arg.c_str());
+        }
+    }
+
+    ReplayPlayer replay;
+    bool replaying = !replayPath.empty();
+    if (replaying && !replay.load(replayPath)) {
+        return 1;
+    }
+
     SDLFramework app;
     if (!app.init("Sigma Strikers", 1280, 720)) {
         SDL_Log("Failed to initialize SDL framework");
@@ -58,11 +65,33 @@ int main(int argc, char** argv) {
     }
     SDL_Log("SDL Framework initialized successfully");
 
+    // HUD fonts load in the background while the menus are up
+    HUD hud;
+    if (!hud.init(app, "assets/fonts/mohave-semibold.otf", 24)) {
+        SDL_Log("Warning: HUD font failed to load");
+    }
+    // Frame profiler: F3 shows the graph, F4 writes profile.csv and
+    // profile_trace.json (records only in SIGMA_PROFILE builds, and only
+    // while the graph is up or a capture is running)
+    ProfilerOverlay profilerOverlay;
+    profilerOverlay.init(app);
+    int profileCapture = 0;   // frames still to record before an F4 dump
+    auto updateProfiling = [&]() {
+        Profiler::instance().setEnabled(Profiler::COMPILED_IN &&
+                                        (profilerOverlay.isVisible() || profileCapture > 0));
+    };
+    auto writeProfile = [&]() {
+        Profiler &prof = Profiler::instance();
+        if (prof.writeCsv("profile.csv") && prof.writeChromeTrace("profile_trace.json")) {
+            SDL_Log("Profile written to profile.csv and profile_trace.json");
+        }
+    };
+
     // ---- Main Menu Loop ----
     GameMode gameMode = MODE_VS_AI;
-    bool wantToPlay = false;
+    bool wantToPlay = replaying;
 
-    while (true) {
+    while (!replaying) {
         MainMenuChoice choice = showMainMenu(app);
         if (choice == MENU_PLAY) {
             gameMode = MODE_VS_AI;
@@ -85,217 +114,204 @@ int main(int argc, char** argv) {
 
     if (!wantToPlay) return 0;
 
+    // Sprites and HUD fonts that are still loading finish here; menu-only
+    // fonts can go
+    if (!showLoadingScreen(app)) return 0;
+    app.getAssets().purgeUnused();
+
     // ---- Initialize Game Objects ----
-    Field field(40.0f, 20.0f);
-    // place a couple of fixed obstacles on the pitch for testing
-    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.5f,
-                                      field.getHeight() * 0.5f),
-                               4.0f, 4.0f));
-    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.2f,
-                                      field.getHeight() * 0.2f),
-                               1.25f, 3.0f));
-    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.8f,
-                                      field.getHeight() * 0.8f),
-                               1.25f, 3.0f));
-    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.75f,
-                                      field.getHeight() * 0.25f),
-                               4.0f, 1.0f));
-    field.addObstacle(Obstacle(Vector(field.getWidth() * 0.25f,
-                                      field.getHeight() * 0.75f),
-                               4.0f, 1.0f));
-    // Ball starts at center, stationary
-    Ball ball(
-        Vector(field.getWidth() / 2.0f, field.getHeight() / 2.0f),
-        Vector(0, 0),
-        0.5f
-    );
-
-    // Team 1 (Blue, left side) - WASD + E to swap
-    KeyBindings kb1 = {SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D, SDLK_e};
-    Team team1(
-        Vector(field.getWidth() * 0.2f, field.getHeight() * 0.35f),
-        Vector(field.getWidth() * 0.2f, field.getHeight() * 0.65f),
-        kb1
-    );
-
-    // Team 2 (Red, right side) - Arrow keys + Right Shift to swap
-    KeyBindings kb2 = {SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDLK_RSHIFT};
-    Team team2(
-        Vector(field.getWidth() * 0.8f, field.getHeight() * 0.35f),
-        Vector(field.getWidth() * 0.8f, field.getHeight() * 0.65f),
-        kb2
-    );
-
-    // HUD
-    HUD hud;
-    if (!hud.init("assets/fonts/mohave-semibold.otf", 24)) {
-        SDL_Log("Warning: HUD font failed to load");
+    MatchSimulation sim = replaying
+        ? replay.createSimulation()
+        : MatchSimulation(MatchSimulation::createDefaultField(), gameMode,
+                          (float)gSettings.matchDuration, gSettings.playersPerTeam);
+    gameMode = sim.getMode();
+
+    // Team 2's AI runs on a worker next to team 1's when there is a core
+    // to spare for it
+    std::unique_ptr<ThreadPool> aiPool;
+    if (std::thread::hardware_concurrency() > 1) {
+        aiPool.reset(new ThreadPool(1));
+        sim.setThreadPool(aiPool.get());
+    }
+
+    // Recording covers one match; it is saved when the match ends or the
+    // game is closed, whichever comes first
+    ReplayRecorder recorder;
+    bool recording = !recordPath.empty() && !replaying;
+    if (recording) {
+        recorder.begin(sim);
+        sim.setRecorder(&recorder);
     }
 
-    // AI Agents
-    // ai1 controls Team 1's inactive player (in all modes)
-    // ai2 controls Team 2 entirely in VS_AI mode, or just inactive player in PvP
-    AIAgent ai1(0.7f);  // Team 1 AI
-    AIAgent ai2(0.8f);  // Team 2 AI (slightly faster reaction for full AI team)
+    // Harder AI levels let the opponents (team 2) decide on the ball with
+    // the rollout planner.  Its choices depend on how fast the machine is,
+    // and replays do not store the AI settings, so recorded and replayed
+    // matches keep the normal AI.
+    float planBudget = aiPlanBudget(gSettings.aiLevel);
+    if (planBudget > 0.0f && !replaying) {
+        if (recording) {
+            SDL_Log("Recording a replay: AI difficulty falls back to Normal");
+        } else {
+            const AIAgent &opponents = sim.getTeamAI(2);
+            AITuning tuning = opponents.getTuning();
+            tuning.planBudget = planBudget;
+            sim.setTeamAI(2, AIAgent(opponents.getReaction(), tuning));
+        }
+    }
+    auto finishRecording = [&]() {
+        if (!recording) return;
+        sim.setRecorder(nullptr);
+        recording = false;
+        if (recorder.save(recordPath)) {
+            SDL_Log("Replay saved to %s (%d steps)", recordPath.c_str(),
+                    recorder.getStepCount());
+        }
+    };
+    // The match runs on its own thread from here on; this thread only
+    // polls events and draws the newest snapshot it published.  The field
+    // never changes during a match, and the teams are only used for their
+    // key bindings.
+    const Field &field = sim.getField();
+    const Team &team1 = sim.getTeam1();
+    const Team &team2 = sim.getTeam2();
+    SimThread simThread(sim, replaying ? &replay : nullptr, replaySpeed);
+    simThread.start();
+    uint32_t seenEvents = 0;
+    bool matchOver = false;
+
+    // Field, players and ball go through one batch per frame, all seen
+    // through the same camera
+    ShapeBatch batch(app.getRenderer());
+    Camera camera;
 
-    // Game timer
-    float matchTime = (float)gSettings.matchDuration;
     float goalMessageTimer = 0.0f;
     std::string goalMessage;
-    bool gameOver = false;
 
     bool running = true;
-    Uint32 lastTicks = SDL_GetTicks();
+    updateProfiling();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
     SDL_Event e;
 
     // ---- Game Loop ----
     while (running) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) running = false;
-            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE) running = false;
-
-            if (!gameOver) {
-                // Team 1 always player-controlled
-                team1.handleEvent(e);
-
-                // Team 2: player-controlled in PvP, AI in vs-AI mode
-                if (gameMode == MODE_PVP) {
-                    team2.handleEvent(e);
+        {
+            PROFILE_SCOPE(ProfileZone::INPUT);
+            while (SDL_PollEvent(&e)) {
+                if (e.type == SDL_QUIT) running = false;
+                if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE) running = false;
+                // Render-target contents are lost with the device
+                if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+                    app.getFieldLayer().invalidate();
                 }
-            }
 
-            // R to restart after game over
-            if (gameOver && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_r) {
-                // Reset everything
-                team1.score = 0;
-                team2.score = 0;
-                matchTime = (float)gSettings.matchDuration;
-                gameOver = false;
-                goalMessageTimer = 0;
-                resetAfterGoal(team1, team2, ball, field);
-            }
-        }
+                // Swap keys are edge-triggered; the simulation ignores them for
+                // AI-controlled teams
+                if (team1.isSwapEvent(e)) simThread.pressSwap(1);
+                if (team2.isSwapEvent(e)) simThread.pressSwap(2);
+
+                // Camera: +/- zoom, C toggles following the ball; F3/F4 profiler
+                if (e.type == SDL_KEYDOWN) {
+                    SDL_Keycode key = e.key.keysym.sym;
+                    if (key == SDLK_EQUALS || key == SDLK_KP_PLUS) {
+                        camera.setZoom(camera.getZoom() * 1.25f);
+                    } else if (key == SDLK_MINUS || key == SDLK_KP_MINUS) {
+                        camera.setZoom(camera.getZoom() / 1.25f);
+                    } else if (key == SDLK_c) {
+                        camera.setMode(camera.getMode() == CameraMode::FOLLOW_BALL
+                                       ? CameraMode::FIXED : CameraMode::FOLLOW_BALL);
+                    } else if (key == SDLK_F3) {
+                        profilerOverlay.toggle();
+                        updateProfiling();
+                    } else if (key == SDLK_F4 && Profiler::COMPILED_IN) {
+                        // With the graph up the history is already there;
+                        // otherwise record a fresh one first
+                        if (profilerOverlay.isVisible()) {
+                            writeProfile();
+                        } else if (profileCapture == 0) {
+                            Profiler::instance().clear();
+                            profileCapture = Profiler::HISTORY;
+                            updateProfiling();
+                            SDL_Log("Recording %d frames for the profile...", profileCapture);
+                        }
+                    }
+                }
 
-        Uint32 now = SDL_GetTicks();
-        float dt = (now - lastTicks) / 1000.0f;
-        if (dt > 0.05f) dt = 0.05f; // cap delta time
-        lastTicks = now;
-
-        if (!gameOver) {
-            // Update timer
-            matchTime -= dt;
-            if (matchTime <= 0.0f) {
-                matchTime = 0.0f;
-                gameOver = true;
-                if (team1.score > team2.score) {
-                    goalMessage = "TEAM 1 WINS!";
-                } else if (team2.score > team1.score) {
-                    goalMessage = "TEAM 2 WINS!";
-                } else {
-                    goalMessage = "DRAW!";
+                // R to restart after game over (watch again when replaying);
+                // the simulation thread is stopped by then
+                if (matchOver && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_r) {
+                    if (replaying) {
+                        ThreadPool *pool = sim.getThreadPool();
+                        sim = replay.createSimulation();
+                        sim.setThreadPool(pool);
+                        replay.rewind();
+                    } else {
+                        sim.restart((float)gSettings.matchDuration);
+                    }
+                    matchOver = false;
+                    goalMessageTimer = 0;
+                    simThread.start();
                 }
-                goalMessageTimer = 99999.0f; // show forever until restart
             }
+        }
 
-            // Goal message countdown
-            if (goalMessageTimer > 0) {
-                goalMessageTimer -= dt;
-            }
+        // Wall-clock frame time, for the camera and the messages only; the
+        // simulation thread keeps its own time
+        Uint64 now = SDL_GetPerformanceCounter();
+        float dt = (float)(now - lastCounter) / (float)SDL_GetPerformanceFrequency();
+        lastCounter = now;
 
-            const Uint8 *keys = SDL_GetKeyboardState(NULL);
-
-            // Update Team 1 (active player is always human-controlled)
-            team1.update(dt, keys, &field);
-            // AI controls Team 1's inactive player (support)
-            ai1.update(dt, team1.getInactivePlayer(), ball, field, true);
-
-            // Update Team 2
-            if (gameMode == MODE_PVP) {
-                // Human controls active player of Team 2
-                team2.update(dt, keys, &field);
-                // AI controls Team 2's inactive player
-                ai2.update(dt, team2.getInactivePlayer(), ball, field, false);
-            } else {
-                // Full AI: updateTeam handles both players with Active/Support
-                // roles, passing logic, and steering behaviors
-                ai2.updateTeam(dt, team2, ball, field, false, team1);
-
-                // Handle passing: when AI decides to pass, apply force to ball
-                if (ai2.didJustPass()) {
-                    float d1 = (team2.p1.pos - ball.pos).length();
-                    float d2 = (team2.p2.pos - ball.pos).length();
-                    Player &passer   = (d1 <= d2) ? team2.p1 : team2.p2;
-                    Player &receiver = (d1 <= d2) ? team2.p2 : team2.p1;
-
-                    Vector passDir = (receiver.pos - ball.pos).normalized();
-                    float passDist = (receiver.pos - ball.pos).length();
-                    float passSpeed = std::min(25.0f, std::max(12.0f, passDist * 1.2f));
-                    ball.vel = passDir * passSpeed;
-                }
+        const Uint8 *keys = SDL_GetKeyboardState(NULL);
+        MatchInputs inputs;
+        inputs.team1 = TeamInput::fromKeyboard(keys, team1.keys);
+        inputs.team2 = TeamInput::fromKeyboard(keys, team2.keys);
+        simThread.setInputs(inputs);
 
-                // Handle shooting: when AI decides to shoot, launch ball at goal
-                if (ai2.didJustShoot()) {
-                    Vector target = ai2.getShotTarget();
-                    Vector shotDir = (target - ball.pos).normalized();
-                    float shotDist = (target - ball.pos).length();
-                    // Shot speed: faster than pass, scales with distance
-                    float shotSpeed = std::min(30.0f, std::max(18.0f, shotDist * 1.5f));
-                    ball.vel = shotDir * shotSpeed;
-                }
-            }
+        const MatchSnapshot &snap = simThread.latest();
 
-            // ---- Player-to-player collision resolution ----
-            // Prevents all 4 players from overlapping each other
-            resolveAllPlayerCollisions(team1, team2);
-
-            // Update ball physics
-            ball.update(dt);
-
-            // ---- Multi-pass collision resolution ----
-            // Run 3 iterations so that if a player pushes the ball into a wall,
-            // the wall pushes it back, and then player collision can fix it again.
-            // This prevents the ball getting permanently stuck between players & walls.
-            int goalResult = 0;
-            for (int iter = 0; iter < 3; ++iter) {
-                // Ball-player collisions (all 4 players)
-                ball.handlePlayerCollision(team1.p1, team1.p1.radius);
-                ball.handlePlayerCollision(team1.p2, team1.p2.radius);
-                ball.handlePlayerCollision(team2.p1, team2.p1.radius);
-                ball.handlePlayerCollision(team2.p2, team2.p2.radius);
-
-                // player-obstacle resolution
-                field.handlePlayerCollision(team1.p1);
-                field.handlePlayerCollision(team1.p2);
-                field.handlePlayerCollision(team2.p1);
-                field.handlePlayerCollision(team2.p2);
-
-                // Ball-wall/obstacle collisions & goal detection
-                int res = field.handleCollision(ball);
-                if (res != 0) goalResult = res;
-            }
-            if (goalResult == 1) {
-                // Left goal - Team 2 scores
-                team2.score++;
+        // Goal message countdown
+        if (!matchOver && goalMessageTimer > 0) {
+            goalMessageTimer -= dt;
+        }
+        if (snap.eventCount != seenEvents) {
+            seenEvents = snap.eventCount;
+            if (snap.lastEvent == MatchEvent::TEAM2_GOAL) {
                 goalMessage = "TEAM 2 SCORES!";
                 goalMessageTimer = 2.0f;
-                resetAfterGoal(team1, team2, ball, field);
-            } else if (goalResult == 2) {
-                // Right goal - Team 1 scores
-                team1.score++;
+            } else if (snap.lastEvent == MatchEvent::TEAM1_GOAL) {
                 goalMessage = "TEAM 1 SCORES!";
                 goalMessageTimer = 2.0f;
-                resetAfterGoal(team1, team2, ball, field);
+            } else if (snap.lastEvent == MatchEvent::MATCH_OVER) {
+                if (snap.leader == 1) {
+                    goalMessage = "TEAM 1 WINS!";
+                } else if (snap.leader == 2) {
+                    goalMessage = "TEAM 2 WINS!";
+                } else {
+                    goalMessage = "DRAW!";
+                }
+                goalMessageTimer = 99999.0f; // show forever until restart
+                // Nothing left to simulate; the recorder is ours again
+                simThread.stop();
+                matchOver = true;
+                finishRecording();
             }
-
         }
+        // Players and ball are drawn between the last two physics steps
+        const float alpha = snap.renderAlpha();
+        const Ball renderBall = snap.renderBall(alpha);
 
         // ---- Render ----
         SDL_SetRenderDrawColor(app.getRenderer(), 20, 20, 40, 255);
         SDL_RenderClear(app.getRenderer());
 
-        // Field
-        field.render(app.getRenderer(), app.getWidth(), app.getHeight(),
-                     app.getFieldTexture());
+        // The transform for everything drawn this frame
+        camera.follow(renderBall.pos, dt);
+        camera.frame(field, app.getWidth(), app.getHeight());
+
+        // Field (static, drawn from the cached layer)
+        {
+            PROFILE_SCOPE(ProfileZone::FIELD_RENDER);
+            app.getFieldLayer().render(batch, field, camera, &app.getSprites());
+        }
 
         // Teams with their colors
         SDL_Color team1Active   = {80, 140, 255, 255};   // bright blue
@@ -304,42 +320,65 @@ int main(int argc, char** argv) {
         SDL_Color team2Active   = gameMode == MODE_VS_AI ? team2Inactive : SDL_Color{255, 100, 100, 255};    // bright red
         
 
-        team1.render(app.getRenderer(), field, app.getWidth(), app.getHeight(),
-                     team1Active, team1Inactive, app.getPlayerTexture());
-        team2.render(app.getRenderer(), field, app.getWidth(), app.getHeight(),
-                     team2Active, team2Inactive, app.getPlayerTexture());
-
-        // Ball
-        ball.render(app.getRenderer(), field, app.getWidth(), app.getHeight(),
-                    app.getBallTexture());
-
-        // HUD (scores + timer)
-        hud.render(app.getRenderer(), app.getWidth(), app.getHeight(),
-                   team1.score, team2.score, matchTime);
-
-        // Goal / Game Over message
-        if (goalMessageTimer > 0) {
-            hud.renderMessage(app.getRenderer(), app.getWidth(), app.getHeight(),
-                              goalMessage);
-            if (gameOver) {
-                // Also show restart instruction
-                SDL_Color white = {200, 200, 200, 255};
-                // Small text below the message
-                SDL_SetRenderDrawBlendMode(app.getRenderer(), SDL_BLENDMODE_BLEND);
-                // We'll use HUD's renderMessage for now, it shows the main message
-                // The "Press R to restart" is handled via a secondary call
-            }
+        {
+            PROFILE_SCOPE(ProfileZone::TEAM_RENDER);
+            snap.renderTeam1(alpha).render(batch, camera, team1Active, team1Inactive,
+                                           &app.getSprites());
+            snap.renderTeam2(alpha).render(batch, camera, team2Active, team2Inactive,
+                                           &app.getSprites());
+
+            // Ball
+            renderBall.render(batch, camera, &app.getSprites());
         }
+        {
+            PROFILE_SCOPE(ProfileZone::SUBMIT);
+            batch.flush();
+        }
+
+        {
+            PROFILE_SCOPE(ProfileZone::HUD_RENDER);
+            // HUD (scores + timer)
+            hud.render(app.getRenderer(), app.getWidth(), app.getHeight(),
+                       snap.team1.score, snap.team2.score, snap.timeRemaining);
 
-        // If game over, show restart text
-        if (gameOver) {
-            hud.renderMessage(app.getRenderer(), app.getWidth(), app.getHeight(),
-                              goalMessage);
+            // Goal / Game Over message
+            if (goalMessageTimer > 0) {
+                hud.renderMessage(app.getRenderer(), app.getWidth(), app.getHeight(),
+                                  goalMessage);
+                if (snap.over) {
+                    // Also show restart instruction
+                    SDL_Color white = {200, 200, 200, 255};
+                    // Small text below the message
+                    SDL_SetRenderDrawBlendMode(app.getRenderer(), SDL_BLENDMODE_BLEND);
+                    // We'll use HUD's renderMessage for now, it shows the main message
+                    // The "Press R to restart" is handled via a secondary call
+                }
+            }
+
+            // If game over, show restart text
+            if (snap.over) {
+                hud.renderMessage(app.getRenderer(), app.getWidth(), app.getHeight(),
+                                  goalMessage);
+            }
         }
 
-        SDL_RenderPresent(app.getRenderer());
-        SDL_Delay(16);
+        // Profiler graph on top of everything
+        profilerOverlay.render(batch, app.getWidth(), app.getHeight());
+
+        app.getAssets().update();
+        // Presentation is paced by vsync
+        {
+            PROFILE_SCOPE(ProfileZone::PRESENT);
+            SDL_RenderPresent(app.getRenderer());
+        }
+        PROFILE_FRAME();
+        if (profileCapture > 0 && --profileCapture == 0) {
+            writeProfile();
+            updateProfiling();
+        }
     }
 
+    simThread.stop();
+    finishRecording();
     return 0;
 }
\ No newline at end of file
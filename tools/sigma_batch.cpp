@@ -0,0 +1,223 @@
+// Headless batch match runner for AI evaluation.
+//
+//   sigma_batch [options]
+//
+// Plays many independent AI vs AI matches concurrently on a work-stealing
+// thread pool and prints win/draw/loss and goal statistics for every AI
+// configuration.  Any tuning option takes a comma-separated list of values;
+// every combination of the lists is evaluated as one configuration:
+//
+//   sigma_batch --matches 2000 --good-shot-angle 0.1,0.15,0.2 --reaction 0.7,0.8
+//
+// plays 2000 matches for each of the six configurations.  The configuration
+// under test ("candidate") plays against the default AI, on the left side in
+// even matches and the right side in odd ones, each pair from the same
+// kick-off seed; all statistics are from the candidate's point of view.
+// Every configuration plays the same seeds, so they are compared on the
+// same set of starts.
+#define SDL_MAIN_HANDLED  // plain main(), no SDL2main needed
+#include "../include/MatchSimulation.h"
+#include "../include/ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// One AI setup being evaluated.
+struct Config {
+    float reaction;
+    AITuning tuning;
+    float duration;
+};
+
+// A sweepable option and where its value goes in a Config.
+struct SweepParam {
+    const char *flag;
+    float Config::*field;          // set for the Config-level values
+    float AITuning::*tuningField;  // set for AITuning values
+    const char *help;
+};
+
+static const SweepParam PARAMS[] = {
+    {"--reaction",         &Config::reaction, nullptr,                        "movement speed factor"},
+    {"--duration",         &Config::duration, nullptr,                        "match length, seconds"},
+    {"--good-shot-angle",  nullptr, &AITuning::goodShotAngle,                 "radians"},
+    {"--good-shot-range",  nullptr, &AITuning::goodShotRange,                 "metres"},
+    {"--great-shot-angle", nullptr, &AITuning::greatShotAngle,                "radians"},
+    {"--great-shot-range", nullptr, &AITuning::greatShotRange,                "metres"},
+    {"--shot-clearance",   nullptr, &AITuning::shotClearance,                 "metres"},
+    {"--pass-min",         nullptr, &AITuning::passMinDistance,               "metres"},
+    {"--pass-max",         nullptr, &AITuning::passMaxDistance,               "metres"},
+    {"--pass-lane",        nullptr, &AITuning::passLaneClearance,             "metres"},
+    {"--pressure",         nullptr, &AITuning::pressureDistance,              "metres"},
+    {"--pressure-pass",    nullptr, &AITuning::pressurePassDistance,          "metres"},
+    {"--shot-cooldown",    nullptr, &AITuning::shotCooldown,                  "seconds"},
+    {"--pass-cooldown",    nullptr, &AITuning::passCooldown,                  "seconds"},
+    {"--plan-budget",      nullptr, &AITuning::planBudget,                    "seconds per decision, 0 = fixed priority"},
+};
+static const int PARAM_COUNT = (int)(sizeof(PARAMS) / sizeof(PARAMS[0]));
+
+static float &paramRef(const SweepParam &p, Config &c) {
+    return p.field ? c.*(p.field) : c.tuning.*(p.tuningField);
+}
+
+// Final score of one match from the candidate's side.  Every match writes
+// its own slot, so no locking is needed; the slots are summed once the
+// pool is idle.
+struct MatchResult {
+    int goalsFor;
+    int goalsAgainst;
+};
+
+static void usage(const char *argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--matches N] [--threads N] [--players N] [--seed N]\n"
+                 "          [--opp-reaction R] [tuning options]\n"
+                 "tuning options (comma-separated lists are swept):\n", argv0);
+    for (const SweepParam &p : PARAMS) {
+        std::fprintf(stderr, "  %-20s %s\n", p.flag, p.help);
+    }
+}
+
+static bool parseList(const char *text, std::vector<float> &out) {
+    out.clear();
+    const char *s = text;
+    while (*s) {
+        char *end;
+        float v = std::strtof(s, &end);
+        if (end == s) return false;
+        out.push_back(v);
+        s = end;
+        if (*s == ',') s++;
+        else if (*s) return false;
+    }
+    return !out.empty();
+}
+
+int main(int argc, char **argv) {
+    int matches = 1000;
+    int threads = 0;
+    int players = 2;
+    unsigned seedBase = 1;
+    float oppReaction = 0.8f;
+
+    Config base{0.8f, AITuning(), 120.0f};
+    std::vector<std::vector<float>> values(PARAM_COUNT);
+    for (int k = 0; k < PARAM_COUNT; ++k) {
+        values[k].push_back(paramRef(PARAMS[k], base));
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        const char *val = argv[++i];
+        if (std::strcmp(arg, "--matches") == 0) {
+            matches = std::atoi(val);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            threads = std::atoi(val);
+        } else if (std::strcmp(arg, "--players") == 0) {
+            players = std::atoi(val);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seedBase = (unsigned)std::strtoul(val, nullptr, 10);
+        } else if (std::strcmp(arg, "--opp-reaction") == 0) {
+            oppReaction = std::strtof(val, nullptr);
+        } else {
+            int k = 0;
+            while (k < PARAM_COUNT && std::strcmp(arg, PARAMS[k].flag) != 0) k++;
+            if (k == PARAM_COUNT || !parseList(val, values[k])) {
+                std::fprintf(stderr, "bad option: %s %s\n", arg, val);
+                usage(argv[0]);
+                return 2;
+            }
+        }
+    }
+    if (matches < 1 || players < 1 || players > 11) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Every combination of the value lists, first option varying slowest
+    std::vector<Config> configs(1, base);
+    for (int k = 0; k < PARAM_COUNT; ++k) {
+        std::vector<Config> next;
+        for (const Config &c : configs) {
+            for (float v : values[k]) {
+                Config n = c;
+                paramRef(PARAMS[k], n) = v;
+                next.push_back(n);
+            }
+        }
+        configs.swap(next);
+    }
+
+    const Field field = MatchSimulation::createDefaultField();
+    const AIAgent opponent(oppReaction);
+    std::vector<MatchResult> results(configs.size() * matches);
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(threads);
+        std::fprintf(stderr, "%zu configurations x %d matches on %d threads\n",
+                     configs.size(), matches, pool.getThreadCount());
+
+        for (size_t c = 0; c < configs.size(); ++c) {
+            for (int m = 0; m < matches; ++m) {
+                pool.submit([&, c, m] {
+                    const Config &cfg = configs[c];
+                    // Seed 0 means "no jitter", so skip it
+                    uint32_t seed = seedBase + (uint32_t)(m / 2);
+                    if (seed == 0) seed = 1;
+                    MatchSimulation sim(field, MODE_AI_VS_AI, cfg.duration, players, seed);
+
+                    int candidate = (m % 2 == 0) ? 1 : 2;
+                    sim.setTeamAI(candidate, AIAgent(cfg.reaction, cfg.tuning));
+                    sim.setTeamAI(3 - candidate, opponent);
+
+                    MatchInputs inputs = {};
+                    while (!sim.isOver()) sim.step(MatchSimulation::FIXED_DT, inputs);
+
+                    int s1 = sim.getTeam1().score;
+                    int s2 = sim.getTeam2().score;
+                    results[c * matches + m] = (candidate == 1) ? MatchResult{s1, s2}
+                                                                : MatchResult{s2, s1};
+                });
+            }
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start).count();
+
+    // ---- Report: one CSV row per configuration ----
+    std::printf("config");
+    for (const SweepParam &p : PARAMS) std::printf(",%s", p.flag + 2);
+    std::printf(",matches,wins,draws,losses,win_rate,goals_for,goals_against,goals_per_match\n");
+
+    for (size_t c = 0; c < configs.size(); ++c) {
+        int wins = 0, draws = 0, losses = 0;
+        long goalsFor = 0, goalsAgainst = 0;
+        for (int m = 0; m < matches; ++m) {
+            const MatchResult &r = results[c * matches + m];
+            if (r.goalsFor > r.goalsAgainst)      wins++;
+            else if (r.goalsFor < r.goalsAgainst) losses++;
+            else                                  draws++;
+            goalsFor += r.goalsFor;
+            goalsAgainst += r.goalsAgainst;
+        }
+
+        std::printf("%zu", c);
+        for (const SweepParam &p : PARAMS) std::printf(",%g", paramRef(p, configs[c]));
+        std::printf(",%d,%d,%d,%d,%.4f,%ld,%ld,%.3f\n",
+                    matches, wins, draws, losses, (double)wins / matches,
+                    goalsFor, goalsAgainst, (double)(goalsFor + goalsAgainst) / matches);
+    }
+
+    std::fprintf(stderr, "%zu matches in %.2f s (%.1f matches/s)\n",
+                 results.size(), seconds, results.size() / seconds);
+    return 0;
+}
@@ -0,0 +1,41 @@
+// Headless replay runner.
+//
+//   sigma_replay <replay.ssr> [more.ssr ...]
+//
+// Plays every replay through MatchSimulation at full speed (no window) and
+// prints one line per file with the final score and state hash.  Diffing
+// this output before and after a physics change shows exactly which
+// recorded matches it affects.
+#define SDL_MAIN_HANDLED  // plain main(), no SDL2main needed
+#include "../include/Replay.h"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <replay.ssr> [more.ssr ...]\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; ++i) {
+        ReplayPlayer replay;
+        if (!replay.load(argv[i])) {
+            failures++;
+            continue;
+        }
+
+        MatchSimulation sim = replay.createSimulation();
+        auto start = std::chrono::steady_clock::now();
+        replay.runToEnd(sim);
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%s steps=%d score=%d-%d time=%.3f hash=%016" PRIx64 " (%.1f ms)\n",
+                    argv[i], replay.getStepCount(),
+                    sim.getTeam1().score, sim.getTeam2().score,
+                    sim.getTimeRemaining(), sim.stateHash(), ms);
+    }
+    return failures ? 1 : 0;
+}